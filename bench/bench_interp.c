@@ -0,0 +1,171 @@
+/**
+ * @file bench_interp.c
+ * @brief Quality versus cost of the ring buffer interpolators.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Build and run:
+ *   cc -O2 -march=native -I.. bench_interp.c -o bench_interp -lm
+ *   ./bench_interp
+ *
+ * A sine is written to a ring buffer and read back at random fractional
+ * positions with each interpolator. For every method it prints:
+ * - ns/sample of the block read (and cycles/sample on x86),
+ * - signal-to-error ratio in dB against the exact sine, at several
+ *   frequencies given as a fraction of the sample rate.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "qx_interp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+#define BENCH_RING_SIZE 4096
+#define BENCH_READS 4096
+#define BENCH_REPEAT 256
+
+enum bench_method {
+        BENCH_LINEAR,
+        BENCH_HERMITE,
+        BENCH_LAGRANGE4,
+        BENCH_SINC8,
+        BENCH_SINC16,
+        BENCH_METHODS
+};
+
+static const char* bench_names[BENCH_METHODS] = {
+        "linear", "hermite", "lagrange4", "sinc8", "sinc16"
+};
+
+static const double bench_freqs[] = { 0.01, 0.05, 0.1, 0.2, 0.3, 0.4 };
+
+static struct qx_sinc_table sinc8;
+static struct qx_sinc_table sinc16;
+
+static double now_ns(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void read_block(enum bench_method method, const float* buf,
+                       const float* index, float* out, size_t n)
+{
+        switch (method) {
+        case BENCH_LINEAR:
+                qx_ring_read_linear_block(buf, BENCH_RING_SIZE, index, out, n);
+                break;
+        case BENCH_HERMITE:
+                qx_ring_read_hermite_block(buf, BENCH_RING_SIZE, index, out, n);
+                break;
+        case BENCH_LAGRANGE4:
+                qx_ring_read_lagrange4_block(buf, BENCH_RING_SIZE, index, out, n);
+                break;
+        case BENCH_SINC8:
+                qx_ring_read_sinc_block(&sinc8, buf, BENCH_RING_SIZE, index, out, n);
+                break;
+        default:
+                qx_ring_read_sinc_block(&sinc16, buf, BENCH_RING_SIZE, index, out, n);
+                break;
+        }
+}
+
+int main(void)
+{
+        static float buf[BENCH_RING_SIZE];
+        static float index[BENCH_READS];
+        static float out[BENCH_READS];
+
+        if (!qx_sinc_table_init(&sinc8, 8, 256) || !qx_sinc_table_init(&sinc16, 16, 256)) {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+        }
+
+        srand(1);
+        for (size_t i = 0; i < BENCH_READS; i++)
+                index[i] = (float)((double)rand() / ((double)RAND_MAX + 1.0) * BENCH_RING_SIZE);
+
+        printf("%-10s %9s", "method", "ns/smp");
+#ifdef BENCH_HAVE_TSC
+        printf(" %9s", "cyc/smp");
+#endif
+        for (size_t f = 0; f < QX_ARRAY_SIZE(bench_freqs); f++)
+                printf("   SNR@%.2f", bench_freqs[f]);
+        printf("\n");
+
+        for (int m = 0; m < BENCH_METHODS; m++) {
+                for (size_t i = 0; i < BENCH_RING_SIZE; i++)
+                        buf[i] = (float)sin(2.0 * M_PI * 0.1 * (double)i);
+
+                double t0 = now_ns();
+#ifdef BENCH_HAVE_TSC
+                unsigned long long c0 = __rdtsc();
+#endif
+                for (int r = 0; r < BENCH_REPEAT; r++)
+                        read_block((enum bench_method)m, buf, index, out, BENCH_READS);
+#ifdef BENCH_HAVE_TSC
+                unsigned long long c1 = __rdtsc();
+#endif
+                double t1 = now_ns();
+                double samples = (double)BENCH_READS * BENCH_REPEAT;
+
+                printf("%-10s %9.3f", bench_names[m], (t1 - t0) / samples);
+#ifdef BENCH_HAVE_TSC
+                printf(" %9.2f", (double)(c1 - c0) / samples);
+#endif
+
+                for (size_t f = 0; f < QX_ARRAY_SIZE(bench_freqs); f++) {
+                        // Whole number of periods so the wraparound is seamless
+                        double cycles = floor(bench_freqs[f] * BENCH_RING_SIZE);
+                        double w = 2.0 * M_PI * cycles / BENCH_RING_SIZE;
+                        for (size_t i = 0; i < BENCH_RING_SIZE; i++)
+                                buf[i] = (float)sin(w * (double)i);
+
+                        read_block((enum bench_method)m, buf, index, out, BENCH_READS);
+
+                        double sig = 0.0, err = 0.0;
+                        for (size_t i = 0; i < BENCH_READS; i++) {
+                                double ref = sin(w * (double)index[i]);
+                                sig += ref * ref;
+                                err += (out[i] - ref) * (out[i] - ref);
+                        }
+                        printf("  %8.1f", 10.0 * log10(sig / (err > 0.0 ? err : 1e-30)));
+                }
+                printf("\n");
+        }
+
+        qx_sinc_table_free(&sinc8);
+        qx_sinc_table_free(&sinc16);
+        return 0;
+}
@@ -0,0 +1,692 @@
+/**
+ * @file bench_primitives.c
+ * @brief Microbenchmarks of the qx_* primitives and block kernels.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Build and run (from the bench directory, x86-64):
+ *   cc -O2 -I.. -I../src -c ../src/qx_dsp.c ../src/qx_dsp_scalar.c ../src/qx_dsp_sse2.c ../src/qx_dsp_neon.c
+ *   cc -O2 -I.. -I../src -mavx -c ../src/qx_dsp_avx.c
+ *   cc -O2 -I.. -I../src -mavx2 -c ../src/qx_dsp_avx2.c
+ *   cc -O2 -I.. -I../src -mavx512f -c ../src/qx_dsp_avx512.c
+ *   cc -O2 -I.. bench_primitives.c qx_dsp*.o -o bench_primitives -lm
+ *   ./bench_primitives [--json FILE] [--quick] [--filter TEXT] [--min-time MS]
+ *
+ * Every primitive is timed for buffer sizes from 32 to 8192 frames. Stateful
+ * primitives are also timed for 1 to 4096 instances, each processing its own
+ * state over a shared buffer. Per-sample header functions are listed with
+ * the ISA "inline"; block kernels are run through the qx_dsp() table of
+ * every instruction set the CPU supports.
+ *
+ * For each case it reports ns/sample, samples/sec and cycles/sample, where
+ * a sample is one frame of one instance. Cycles are TSC ticks (x86 only),
+ * which run at the nominal rather than the boost frequency. The best of
+ * three trials is kept. --json writes the same results for diffing
+ * between releases. Denormals are flushed to zero, like in a real-time
+ * audio thread.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "qx_crossfader.h"
+#include "qx_delay_line.h"
+#include "qx_dsp.h"
+#include "qx_fader.h"
+#include "qx_interp.h"
+#include "qx_math.h"
+#include "qx_noise.h"
+#include "qx_randomizer.h"
+#include "qx_smoother.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+#define BENCH_MAX_FRAMES 8192
+#define BENCH_MAX_INSTANCES 4096
+#define BENCH_MAX_DELAY_LINES 256
+#define BENCH_RING_SIZE 4096
+#define BENCH_TRIALS 3
+
+static const size_t bench_frames[] = { 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+static const size_t bench_instances[] = { 1, 4, 16, 64, 256, 1024, 4096 };
+static const size_t bench_quick_frames[] = { 64, 1024 };
+static const size_t bench_quick_instances[] = { 1, 64 };
+
+struct bench_ctx {
+        const struct qx_dsp_kernels* k;
+        size_t frames;
+        size_t instances;
+
+        float* in;              /**< 2 * BENCH_MAX_FRAMES, also used as interleaved stereo */
+        float* out;             /**< 2 * BENCH_MAX_FRAMES */
+        double* in_d;
+        double* out_d;
+        float* index;           /**< Fractional read positions into ring */
+        float* delays;          /**< Modulated delays for the delay lines */
+        float* ring;
+        float** bufs;           /**< BENCH_MAX_INSTANCES pointers to out */
+        float phase;
+
+        struct qx_fader* faders;
+        struct qx_crossfader* crossfaders;
+        qx_smoother* smoothers;
+        struct qx_randomizer* rands;
+        struct qx_noise* noises;
+        struct qx_delay_line* lines;
+        size_t lines_count;
+        struct qx_fader_bank fader_bank;
+        qx_smoother_bank smoother_bank;
+        size_t bank_count;
+        struct qx_sinc_table sinc;
+        float sink;
+};
+
+struct bench_case {
+        const char* name;
+        bool table;             /**< Run once per qx_dsp() table */
+        size_t max_instances;   /**< 1 for stateless kernels */
+        void (*prepare)(struct bench_ctx* c);
+        void (*run)(struct bench_ctx* c);
+};
+
+struct bench_result {
+        const char* name;
+        const char* isa;
+        size_t frames;
+        size_t instances;
+        double ns;
+        double cycles;
+};
+
+static double now_ns(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static unsigned long long now_cycles(void)
+{
+#ifdef BENCH_HAVE_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+}
+
+/*
+ * Preparation: put the state in a transition long enough to never finish
+ * during a trial, so the ramp code rather than the steady state is measured.
+ */
+
+static void prepare_faders(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_fader_init(&c->faders[i], 1e9f, 48000.0f);
+                c->faders[i].fade = 0.5f;
+                qx_fader_enable(&c->faders[i], i & 1);
+        }
+}
+
+static void prepare_faders_equal_power(struct bench_ctx* c)
+{
+        prepare_faders(c);
+        for (size_t i = 0; i < c->instances; i++)
+                qx_fader_set_curve(&c->faders[i], QX_FADER_CURVE_EQUAL_POWER);
+}
+
+static void prepare_crossfaders(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_crossfader_init(&c->crossfaders[i], 1e9f, 48000.0f);
+                qx_crossfader_set_curve(&c->crossfaders[i], QX_FADER_CURVE_EQUAL_POWER);
+                qx_crossfader_set_position(&c->crossfaders[i], 0.5f);
+                qx_crossfader_start(&c->crossfaders[i], i & 1, 0);
+        }
+}
+
+static void prepare_smoothers(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_smoother_init(&c->smoothers[i], 0.0f, 1u << 30);
+                qx_smoother_set_target(&c->smoothers[i], 1.0f);
+        }
+}
+
+static void prepare_rands(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_randomizer_init(&c->rands[i], -1.0f, 1.0f, 0.0001f);
+                qx_randomizer_set_seed(&c->rands[i], (uint32_t)i + 1);
+        }
+}
+
+static void prepare_noises(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_noise_init(&c->noises[i], QX_NOISE_PINK, 48000.0f);
+                qx_noise_set_seed(&c->noises[i], (uint32_t)i + 1);
+        }
+}
+
+static void prepare_lines(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->lines_count; i++)
+                qx_delay_line_free(&c->lines[i]);
+        c->lines_count = 0;
+        for (size_t i = 0; i < c->instances; i++) {
+                if (!qx_delay_line_init(&c->lines[i], 1024, BENCH_MAX_FRAMES))
+                        break;
+                c->lines_count++;
+        }
+}
+
+static void prepare_banks(struct bench_ctx* c)
+{
+        if (c->bank_count != c->instances) {
+                qx_fader_bank_free(&c->fader_bank);
+                qx_smoother_bank_free(&c->smoother_bank);
+                qx_fader_bank_init(&c->fader_bank, c->instances, 1e9f, 48000.0f);
+                qx_smoother_bank_init(&c->smoother_bank, c->instances, 0.0f, 1u << 30);
+                c->bank_count = c->instances;
+        }
+        for (size_t i = 0; i < c->instances; i++) {
+                qx_fader_bank_enable(&c->fader_bank, i, true);
+                qx_smoother_bank_set_target(&c->smoother_bank, i, (float)(i & 1));
+        }
+}
+
+/* Per-sample header functions */
+
+static void run_fader_fade(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                for (size_t j = 0; j < c->frames; j++)
+                        c->out[j] = qx_fader_fade(&c->faders[i], c->in[j]);
+}
+
+static void run_smoother_next(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                for (size_t j = 0; j < c->frames; j++)
+                        c->out[j] = qx_smoother_next(&c->smoothers[i]);
+}
+
+static void run_randomizer_get_float(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                for (size_t j = 0; j < c->frames; j++)
+                        c->out[j] = qx_randomizer_get_float(&c->rands[i]);
+}
+
+static void run_ring_interp_linear(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_ring_interp_linear(c->ring, c->index[j], BENCH_RING_SIZE);
+}
+
+static void run_ring_interp_hermite(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_ring_interp_hermite(c->ring, c->index[j], BENCH_RING_SIZE);
+}
+
+static void run_ring_interp_sinc(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_ring_interp_sinc(&c->sinc, c->ring, c->index[j], BENCH_RING_SIZE);
+}
+
+static void run_wrapf(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_wrapf(c->in[j], 6.2831853f);
+}
+
+static void run_db_to_val(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_db_to_val(c->in[j]);
+}
+
+static void run_db_to_val_fast(struct bench_ctx* c)
+{
+        for (size_t j = 0; j < c->frames; j++)
+                c->out[j] = qx_db_to_val_fast(c->in[j]);
+}
+
+static void run_delay_line_tap(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->lines_count; i++) {
+                for (size_t j = 0; j < c->frames; j++) {
+                        qx_delay_line_push(&c->lines[i], c->in[j]);
+                        c->out[j] = qx_delay_line_tap(&c->lines[i], c->delays[j]);
+                }
+        }
+}
+
+/* Block kernels through the dispatch table */
+
+static void run_fader_block(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->fader_process_block_out(&c->faders[i], c->in, c->out, c->frames);
+}
+
+static void run_fader_interleaved(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->fader_process_interleaved_out(&c->faders[i], c->in, c->out, c->frames, 2);
+}
+
+static void run_crossfader_block(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->crossfader_process_block(&c->crossfaders[i], c->in, c->in + BENCH_MAX_FRAMES,
+                                               c->out, c->frames);
+}
+
+static void run_fader_bank(struct bench_ctx* c)
+{
+        c->k->fader_bank_process(&c->fader_bank, c->bufs, c->frames);
+}
+
+static void run_smoother_block(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->smoother_process_block(&c->smoothers[i], c->out, c->frames);
+}
+
+static void run_smoother_gain(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->smoother_apply_gain_block(&c->smoothers[i], c->in, c->out, c->frames);
+}
+
+static void run_smoother_bank(struct bench_ctx* c)
+{
+        c->k->smoother_bank_process(&c->smoother_bank, c->bufs, c->frames);
+}
+
+static void run_randomizer_fill(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->randomizer_fill(&c->rands[i], c->out, c->frames);
+}
+
+static void run_dist_normal_fill(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->dist_normal_fill(&c->rands[i], 0.0f, 1.0f, c->out, c->frames);
+}
+
+static void run_dist_exponential_fill(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->dist_exponential_fill(&c->rands[i], 1.0f, c->out, c->frames);
+}
+
+static void run_noise_pink_fill(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->instances; i++)
+                c->k->noise_fill(&c->noises[i], c->out, c->frames);
+}
+
+static void run_delay_line_process(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->lines_count; i++)
+                c->k->delay_line_process(&c->lines[i], c->in, c->delays, c->out, c->frames);
+}
+
+static void run_delay_line_fixed(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->lines_count; i++)
+                c->k->delay_line_read_fixed(&c->lines[i], 100.5f, c->out, c->frames);
+}
+
+static void run_simd_ramp_mul(struct bench_ctx* c)
+{
+        c->k->simd_ramp_mul(c->in, c->out, c->frames, 0.0f, 1e-5f, 0.0f, 1.0f);
+}
+
+static void run_db_to_val_array(struct bench_ctx* c)
+{
+        c->k->db_to_val_array(c->in, c->out, c->frames);
+}
+
+static void run_val_to_db_array(struct bench_ctx* c)
+{
+        c->k->val_to_db_array(c->in, c->out, c->frames);
+}
+
+static void run_wrapf_array(struct bench_ctx* c)
+{
+        c->k->wrapf_array(c->in, c->out, c->frames, 6.2831853f);
+}
+
+static void run_phase_fill(struct bench_ctx* c)
+{
+        c->k->phase_fill(&c->phase, 0.0123f, c->out, c->frames);
+}
+
+static void run_denormalize_clamp_array(struct bench_ctx* c)
+{
+        c->k->denormalize_clamp_array_float(c->in, c->out, c->frames, 20.0f, 20000.0f);
+}
+
+static void run_normalize_array_double(struct bench_ctx* c)
+{
+        c->k->normalize_array_double(c->in_d, c->out_d, c->frames, -10.0, 10.0);
+}
+
+static void run_ring_read_linear(struct bench_ctx* c)
+{
+        c->k->ring_read_linear_block(c->ring, BENCH_RING_SIZE, c->index, c->out, c->frames);
+}
+
+static void run_ring_read_hermite(struct bench_ctx* c)
+{
+        c->k->ring_read_hermite_block(c->ring, BENCH_RING_SIZE, c->index, c->out, c->frames);
+}
+
+static void run_ring_read_sinc(struct bench_ctx* c)
+{
+        c->k->ring_read_sinc_block(&c->sinc, c->ring, BENCH_RING_SIZE, c->index, c->out, c->frames);
+}
+
+static const struct bench_case bench_cases[] = {
+        { "fader_fade", false, BENCH_MAX_INSTANCES, prepare_faders, run_fader_fade },
+        { "fader_fade_equal_power", false, BENCH_MAX_INSTANCES, prepare_faders_equal_power, run_fader_fade },
+        { "smoother_next", false, BENCH_MAX_INSTANCES, prepare_smoothers, run_smoother_next },
+        { "randomizer_get_float", false, BENCH_MAX_INSTANCES, prepare_rands, run_randomizer_get_float },
+        { "ring_interp_linear", false, 1, NULL, run_ring_interp_linear },
+        { "ring_interp_hermite", false, 1, NULL, run_ring_interp_hermite },
+        { "ring_interp_sinc16", false, 1, NULL, run_ring_interp_sinc },
+        { "wrapf", false, 1, NULL, run_wrapf },
+        { "db_to_val", false, 1, NULL, run_db_to_val },
+        { "db_to_val_fast", false, 1, NULL, run_db_to_val_fast },
+        { "delay_line_tap", false, BENCH_MAX_DELAY_LINES, prepare_lines, run_delay_line_tap },
+
+        { "fader_process_block", true, BENCH_MAX_INSTANCES, prepare_faders, run_fader_block },
+        { "fader_process_block_equal_power", true, BENCH_MAX_INSTANCES, prepare_faders_equal_power, run_fader_block },
+        { "fader_process_interleaved_2ch", true, BENCH_MAX_INSTANCES, prepare_faders, run_fader_interleaved },
+        { "crossfader_process_block", true, BENCH_MAX_INSTANCES, prepare_crossfaders, run_crossfader_block },
+        { "fader_bank_process", true, BENCH_MAX_INSTANCES, prepare_banks, run_fader_bank },
+        { "smoother_process_block", true, BENCH_MAX_INSTANCES, prepare_smoothers, run_smoother_block },
+        { "smoother_apply_gain_block", true, BENCH_MAX_INSTANCES, prepare_smoothers, run_smoother_gain },
+        { "smoother_bank_process", true, BENCH_MAX_INSTANCES, prepare_banks, run_smoother_bank },
+        { "randomizer_fill", true, BENCH_MAX_INSTANCES, prepare_rands, run_randomizer_fill },
+        { "dist_normal_fill", true, BENCH_MAX_INSTANCES, prepare_rands, run_dist_normal_fill },
+        { "dist_exponential_fill", true, BENCH_MAX_INSTANCES, prepare_rands, run_dist_exponential_fill },
+        { "noise_pink_fill", true, BENCH_MAX_INSTANCES, prepare_noises, run_noise_pink_fill },
+        { "delay_line_process", true, BENCH_MAX_DELAY_LINES, prepare_lines, run_delay_line_process },
+        { "delay_line_read_fixed", true, BENCH_MAX_DELAY_LINES, prepare_lines, run_delay_line_fixed },
+        { "simd_ramp_mul", true, 1, NULL, run_simd_ramp_mul },
+        { "db_to_val_array", true, 1, NULL, run_db_to_val_array },
+        { "val_to_db_array", true, 1, NULL, run_val_to_db_array },
+        { "wrapf_array", true, 1, NULL, run_wrapf_array },
+        { "phase_fill", true, 1, NULL, run_phase_fill },
+        { "denormalize_clamp_array_float", true, 1, NULL, run_denormalize_clamp_array },
+        { "normalize_array_double", true, 1, NULL, run_normalize_array_double },
+        { "ring_read_linear_block", true, 1, NULL, run_ring_read_linear },
+        { "ring_read_hermite_block", true, 1, NULL, run_ring_read_hermite },
+        { "ring_read_sinc16_block", true, 1, NULL, run_ring_read_sinc },
+};
+
+static bool bench_ctx_init(struct bench_ctx* c)
+{
+        memset(c, 0, sizeof(*c));
+        c->in = (float*)calloc(2 * BENCH_MAX_FRAMES, sizeof(float));
+        c->out = (float*)calloc(2 * BENCH_MAX_FRAMES, sizeof(float));
+        c->in_d = (double*)calloc(BENCH_MAX_FRAMES, sizeof(double));
+        c->out_d = (double*)calloc(BENCH_MAX_FRAMES, sizeof(double));
+        c->index = (float*)calloc(BENCH_MAX_FRAMES, sizeof(float));
+        c->delays = (float*)calloc(BENCH_MAX_FRAMES, sizeof(float));
+        c->ring = (float*)calloc(BENCH_RING_SIZE, sizeof(float));
+        c->bufs = (float**)calloc(BENCH_MAX_INSTANCES, sizeof(float*));
+        c->faders = (struct qx_fader*)calloc(BENCH_MAX_INSTANCES, sizeof(struct qx_fader));
+        c->crossfaders = (struct qx_crossfader*)calloc(BENCH_MAX_INSTANCES, sizeof(struct qx_crossfader));
+        c->smoothers = (qx_smoother*)calloc(BENCH_MAX_INSTANCES, sizeof(qx_smoother));
+        c->rands = (struct qx_randomizer*)calloc(BENCH_MAX_INSTANCES, sizeof(struct qx_randomizer));
+        c->noises = (struct qx_noise*)calloc(BENCH_MAX_INSTANCES, sizeof(struct qx_noise));
+        c->lines = (struct qx_delay_line*)calloc(BENCH_MAX_DELAY_LINES, sizeof(struct qx_delay_line));
+        if (!c->in || !c->out || !c->in_d || !c->out_d || !c->index || !c->delays || !c->ring
+            || !c->bufs || !c->faders || !c->crossfaders || !c->smoothers || !c->rands || !c->noises || !c->lines
+            || !qx_sinc_table_init(&c->sinc, 16, 256))
+                return false;
+
+        srand(1);
+        for (size_t i = 0; i < 2 * BENCH_MAX_FRAMES; i++)
+                c->in[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+        for (size_t i = 0; i < BENCH_MAX_FRAMES; i++) {
+                c->in_d[i] = c->in[i];
+                c->index[i] = (float)rand() / ((float)RAND_MAX + 1.0f) * (float)(BENCH_RING_SIZE - 1);
+                c->delays[i] = 500.0f + 400.0f * sinf(0.001f * (float)i);
+        }
+        for (size_t i = 0; i < BENCH_RING_SIZE; i++)
+                c->ring[i] = sinf(0.05f * (float)i);
+        for (size_t i = 0; i < BENCH_MAX_INSTANCES; i++)
+                c->bufs[i] = c->out;
+        return true;
+}
+
+static void bench_ctx_free(struct bench_ctx* c)
+{
+        for (size_t i = 0; i < c->lines_count; i++)
+                qx_delay_line_free(&c->lines[i]);
+        qx_fader_bank_free(&c->fader_bank);
+        qx_smoother_bank_free(&c->smoother_bank);
+        qx_sinc_table_free(&c->sinc);
+        free(c->in);
+        free(c->out);
+        free(c->in_d);
+        free(c->out_d);
+        free(c->index);
+        free(c->delays);
+        free(c->ring);
+        free(c->bufs);
+        free(c->faders);
+        free(c->crossfaders);
+        free(c->smoothers);
+        free(c->rands);
+        free(c->noises);
+        free(c->lines);
+}
+
+static void bench_measure(struct bench_ctx* c, const struct bench_case* bc,
+                          double min_time_ns, struct bench_result* r)
+{
+        // Calibrate the number of repetitions to fill the minimum time
+        size_t reps = 1;
+        for (;;) {
+                if (bc->prepare)
+                        bc->prepare(c);
+                double t0 = now_ns();
+                for (size_t i = 0; i < reps; i++)
+                        bc->run(c);
+                if (now_ns() - t0 >= min_time_ns / 4 || reps >= ((size_t)1 << 24))
+                        break;
+                reps *= 2;
+        }
+        reps *= 4;
+
+        double samples = (double)reps * (double)c->frames
+                         * (double)(bc->prepare == prepare_lines ? c->lines_count : c->instances);
+        r->ns = INFINITY;
+        r->cycles = INFINITY;
+        for (int t = 0; t < BENCH_TRIALS; t++) {
+                if (bc->prepare)
+                        bc->prepare(c);
+                unsigned long long c0 = now_cycles();
+                double t0 = now_ns();
+                for (size_t i = 0; i < reps; i++)
+                        bc->run(c);
+                double t1 = now_ns();
+                unsigned long long c1 = now_cycles();
+                if ((t1 - t0) / samples < r->ns) {
+                        r->ns = (t1 - t0) / samples;
+                        r->cycles = (double)(c1 - c0) / samples;
+                }
+        }
+        c->sink += c->out[c->frames - 1];
+}
+
+static void bench_write_json(FILE* f, const struct bench_result* results, size_t n)
+{
+        fprintf(f, "{\n  \"benchmark\": \"qx_primitives\",\n");
+        fprintf(f, "  \"detected_isa\": \"%s\",\n", qx_dsp_isa_name(qx_dsp_get_isa()));
+        fprintf(f, "  \"results\": [\n");
+        for (size_t i = 0; i < n; i++) {
+                const struct bench_result* r = &results[i];
+                fprintf(f, "    {\"name\": \"%s\", \"isa\": \"%s\", \"frames\": %zu, \"instances\": %zu, "
+                        "\"ns_per_sample\": %.4f, \"samples_per_sec\": %.0f, ",
+                        r->name, r->isa, r->frames, r->instances, r->ns, 1e9 / r->ns);
+#ifdef BENCH_HAVE_TSC
+                fprintf(f, "\"cycles_per_sample\": %.4f}", r->cycles);
+#else
+                fprintf(f, "\"cycles_per_sample\": null}");
+#endif
+                fprintf(f, "%s\n", i + 1 < n ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+        const char* json_path = NULL;
+        const char* filter = NULL;
+        double min_time_ms = 0.5;
+        bool quick = false;
+
+        for (int i = 1; i < argc; i++) {
+                if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+                        json_path = argv[++i];
+                } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+                        filter = argv[++i];
+                } else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+                        min_time_ms = atof(argv[++i]);
+                } else if (!strcmp(argv[i], "--quick")) {
+                        quick = true;
+                } else {
+                        fprintf(stderr, "usage: %s [--json FILE] [--quick] [--filter TEXT] [--min-time MS]\n",
+                                argv[0]);
+                        return 1;
+                }
+        }
+
+#if defined(__SSE__) || defined(__x86_64__)
+        _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ and DAZ
+#endif
+
+        struct bench_ctx ctx;
+        if (!bench_ctx_init(&ctx)) {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+        }
+
+        const size_t* frames = quick ? bench_quick_frames : bench_frames;
+        size_t frames_count = quick ? QX_ARRAY_SIZE(bench_quick_frames) : QX_ARRAY_SIZE(bench_frames);
+        const size_t* instances = quick ? bench_quick_instances : bench_instances;
+        size_t instances_count = quick ? QX_ARRAY_SIZE(bench_quick_instances) : QX_ARRAY_SIZE(bench_instances);
+
+        size_t capacity = 1024;
+        size_t n = 0;
+        struct bench_result* results = (struct bench_result*)malloc(capacity * sizeof(*results));
+        if (!results)
+                return 1;
+
+        qx_dsp_init();
+        enum qx_dsp_isa detected = qx_dsp_get_isa();
+        printf("detected ISA: %s\n", qx_dsp_isa_name(detected));
+        printf("%-32s %-7s %6s %6s %10s %14s %10s\n",
+               "name", "isa", "frames", "inst", "ns/smp", "smp/s", "cyc/smp");
+
+        for (size_t ci = 0; ci < QX_ARRAY_SIZE(bench_cases); ci++) {
+                const struct bench_case* bc = &bench_cases[ci];
+                if (filter && !strstr(bc->name, filter))
+                        continue;
+
+                for (int isa = 0; isa < QX_DSP_ISA_COUNT; isa++) {
+                        if (bc->table ? !qx_dsp_set_isa((enum qx_dsp_isa)isa) : isa > 0)
+                                continue;
+                        ctx.k = qx_dsp();
+
+                        for (size_t fi = 0; fi < frames_count; fi++) {
+                                for (size_t ii = 0; ii < instances_count; ii++) {
+                                        if (instances[ii] > bc->max_instances)
+                                                continue;
+
+                                        ctx.frames = frames[fi];
+                                        ctx.instances = instances[ii];
+                                        if (n == capacity) {
+                                                capacity *= 2;
+                                                struct bench_result* grown = (struct bench_result*)realloc(results, capacity * sizeof(*results));
+                                                if (!grown)
+                                                        return 1;
+                                                results = grown;
+                                        }
+
+                                        struct bench_result* r = &results[n++];
+                                        r->name = bc->name;
+                                        r->isa = bc->table ? qx_dsp_isa_name((enum qx_dsp_isa)isa) : "inline";
+                                        r->frames = ctx.frames;
+                                        r->instances = ctx.instances;
+                                        bench_measure(&ctx, bc, min_time_ms * 1e6, r);
+
+                                        printf("%-32s %-7s %6zu %6zu %10.3f %14.0f",
+                                               r->name, r->isa, r->frames, r->instances, r->ns, 1e9 / r->ns);
+#ifdef BENCH_HAVE_TSC
+                                        printf(" %10.3f\n", r->cycles);
+#else
+                                        printf(" %10s\n", "-");
+#endif
+                                        fflush(stdout);
+                                }
+                        }
+                }
+        }
+        qx_dsp_set_isa(detected);
+
+        if (json_path) {
+                FILE* f = fopen(json_path, "w");
+                if (!f) {
+                        fprintf(stderr, "can't write %s\n", json_path);
+                        return 1;
+                }
+                bench_write_json(f, results, n);
+                fclose(f);
+        }
+
+        free(results);
+        bench_ctx_free(&ctx);
+        return ctx.sink == 12345.0f;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file qx_crossfader.h
+ * @brief Sample-accurate crossfade between two signals with one shared ramp.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_CROSSFADER_H
+#define QX_CROSSFADER_H
+
+#include "qx_fader.h"
+#include "qx_simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Crossfade between two signals.
+ *
+ * One qx_fader ramp holds the position: 0 plays input a, 1 plays input b.
+ * Input b gets the gain curve(position) and input a curve(1 - position),
+ * so the equal-power curve gives a sine/cosine crossfade. A fade can be
+ * started at a sample offset inside the next block.
+ */
+typedef struct qx_crossfader {
+        struct qx_fader ramp; /**< Position in ramp.fade, direction in ramp.enabled (true = towards b) */
+        size_t delay;         /**< Frames before the ramp switches to the pending direction */
+        bool pending;         /**< Direction from the start offset on (true = towards b) */
+} qx_crossfader;
+
+/**
+ * @brief Initialize a crossfader playing input a.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param fadeTime Time of a full crossfade in milliseconds.
+ * @param sample_rate Audio sample rate.
+ */
+static inline void qx_crossfader_init(struct qx_crossfader* xf, float fadeTime, float sample_rate)
+{
+        qx_fader_init(&xf->ramp, fadeTime, sample_rate);
+        xf->delay = 0;
+        xf->pending = false;
+}
+
+/**
+ * @brief Set the gain curve of the crossfader.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param curve Gain curve.
+ */
+static inline void qx_crossfader_set_curve(struct qx_crossfader* xf, enum qx_fader_curve curve)
+{
+        qx_fader_set_curve(&xf->ramp, curve);
+}
+
+/**
+ * @brief Start a crossfade.
+ *
+ * The ramp continues from the current position, so reversing a fade in
+ * progress does not click.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param to_b True to fade towards input b, false towards input a.
+ * @param offset Frames of the next block, or of the next per-sample calls,
+ *               that still follow the current direction: a fade in
+ *               progress keeps running up to the event and a finished
+ *               one keeps its gains. Frame @p offset is the first one
+ *               moving towards the new target. A later call replaces a
+ *               start that is still pending.
+ */
+static inline void qx_crossfader_start(struct qx_crossfader* xf, bool to_b, size_t offset)
+{
+        xf->pending = to_b;
+        xf->delay = offset;
+        if (offset == 0)
+                xf->ramp.enabled = to_b;
+}
+
+/**
+ * @brief Jump to a position without fading.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param position Position [0..1], 0 plays a and 1 plays b.
+ */
+static inline void qx_crossfader_set_position(struct qx_crossfader* xf, float position)
+{
+        xf->ramp.fade = qx_clamp_float(position, 0.0f, 1.0f);
+        xf->ramp.enabled = xf->pending;
+        xf->delay = 0;
+}
+
+/**
+ * @brief Current position of the crossfader.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @return Position [0..1], 0 plays a and 1 plays b.
+ */
+static inline float qx_crossfader_position(const struct qx_crossfader* xf)
+{
+        return xf->ramp.fade;
+}
+
+/**
+ * @brief Crossfade a single sample.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param a Sample of input a.
+ * @param b Sample of input b.
+ * @return Mixed sample.
+ */
+static inline float qx_crossfader_process(struct qx_crossfader* xf, float a, float b)
+{
+        if (xf->delay > 0)
+                xf->delay--;
+        else
+                xf->ramp.enabled = xf->pending;
+
+        float fade = xf->ramp.fade + (xf->ramp.enabled ? xf->ramp.step : -xf->ramp.step);
+        xf->ramp.fade = qx_clamp_float(fade, 0.0f, 1.0f);
+
+        float x = xf->ramp.fade;
+        return a * qx_fader_curve_gain(xf->ramp.curve, 1.0f - x)
+               + b * qx_fader_curve_gain(xf->ramp.curve, x);
+}
+
+/**
+ * @brief Mix a block with the gains of the current position.
+ */
+static inline void qx_crossfader_hold(const struct qx_crossfader* xf,
+                                      const float* a,
+                                      const float* b,
+                                      float* out,
+                                      size_t frames)
+{
+        float x = xf->ramp.fade;
+        qx_simd_mix_gain(a, b, out, frames,
+                         qx_fader_curve_gain(xf->ramp.curve, 1.0f - x),
+                         qx_fader_curve_gain(xf->ramp.curve, x));
+}
+
+/**
+ * @brief Crossfade a block in the current direction of the ramp.
+ */
+static inline void qx_crossfader_run(struct qx_crossfader* xf,
+                                     const float* a,
+                                     const float* b,
+                                     float* out,
+                                     size_t frames)
+{
+        size_t ramp = qx_fader_ramp_frames(&xf->ramp, frames);
+        if (ramp > 0) {
+                float delta = xf->ramp.enabled ? xf->ramp.step : -xf->ramp.step;
+                float ga[QX_FADER_CHUNK_FRAMES];
+                float gb[QX_FADER_CHUNK_FRAMES];
+                for (size_t i = 0; i < ramp; i += QX_FADER_CHUNK_FRAMES) {
+                        size_t n = ramp - i;
+                        if (n > QX_FADER_CHUNK_FRAMES)
+                                n = QX_FADER_CHUNK_FRAMES;
+
+                        // a runs the mirrored ramp
+                        float start = xf->ramp.fade + delta * (float)i;
+                        qx_simd_ramp_fill(ga, n, 1.0f - start, -delta, 0.0f, 1.0f);
+                        qx_fader_curve_array(xf->ramp.curve, ga, ga, n);
+                        qx_fader_gain_fill(&xf->ramp, gb, i, n);
+                        qx_simd_mix(a + i, ga, b + i, gb, out + i, n);
+                }
+        }
+
+        qx_fader_advance(&xf->ramp, frames);
+        if (ramp < frames)
+                qx_crossfader_hold(xf, a + ramp, b + ramp, out + ramp, frames - ramp);
+}
+
+/**
+ * @brief Crossfade a block.
+ *
+ * @param xf Pointer to qx_crossfader struct.
+ * @param a Input a.
+ * @param b Input b.
+ * @param out Output (may be the same as @p a or @p b).
+ * @param frames Number of samples.
+ *
+ * Same gains as calling qx_crossfader_process() for every sample, up to
+ * float rounding of the ramp. The block is split at the start offset;
+ * each part ramps with SIMD and the part after the end of the ramp uses
+ * constant gains, a plain copy once fully faded.
+ */
+static inline void qx_crossfader_process_block(struct qx_crossfader* xf,
+                                               const float* a,
+                                               const float* b,
+                                               float* out,
+                                               size_t frames)
+{
+        size_t pos = xf->delay < frames ? xf->delay : frames;
+        if (pos > 0) {
+                qx_crossfader_run(xf, a, b, out, pos);
+                xf->delay -= pos;
+        }
+
+        if (xf->delay == 0)
+                xf->ramp.enabled = xf->pending;
+        if (pos < frames)
+                qx_crossfader_run(xf, a + pos, b + pos, out + pos, frames - pos);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_CROSSFADER_H
@@ -0,0 +1,383 @@
+/**
+ * @file qx_delay_line.h
+ * @brief Power-of-two ring buffer delay line with modulated block reads.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_DELAY_LINE_H
+#define QX_DELAY_LINE_H
+
+#include "qx_interp.h"
+#include "qx_simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Storage layout: logical sample x (0 <= x < capacity) lives at data[x + 1].
+ * data[0] mirrors the last sample and data[capacity + 1 .. capacity + 3]
+ * mirror the first three, so a 4-point read at any masked position is one
+ * contiguous access and never needs to wrap.
+ *
+ * Delays are in samples, relative to the sample written in the same frame:
+ * a delay of 0 returns the current input. Reads are valid for delays up to
+ * the max_delay given at init.
+ */
+
+/** Number of guard samples around the ring (1 before, 3 after). */
+#define QX_DELAY_LINE_GUARD 4
+
+/** Largest ring size; the positions are 32-bit. */
+#define QX_DELAY_LINE_MAX_CAPACITY 0x80000000u
+
+/**
+ * @brief Delay line state.
+ */
+struct qx_delay_line {
+        float* data;            /**< capacity + QX_DELAY_LINE_GUARD samples */
+        uint32_t capacity;      /**< Ring size, a power of two */
+        uint32_t mask;          /**< capacity - 1 */
+        uint32_t write_pos;     /**< Logical position of the next write */
+};
+
+/**
+ * @brief Initialize a delay line.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param max_delay Largest delay in samples that will be read.
+ * @param max_frames Largest block size passed to the block functions.
+ * @return true on success, false if memory allocation failed or the
+ *         line would need more than QX_DELAY_LINE_MAX_CAPACITY samples.
+ *
+ * The capacity is the next power of two that holds max_delay plus one block
+ * plus the interpolation neighbours. Must be released with qx_delay_line_free().
+ */
+static inline bool qx_delay_line_init(struct qx_delay_line* line,
+                                      size_t max_delay,
+                                      size_t max_frames)
+{
+        line->data = NULL;
+        line->capacity = line->mask = line->write_pos = 0;
+        if (max_delay > QX_DELAY_LINE_MAX_CAPACITY - QX_DELAY_LINE_GUARD
+            || max_frames > QX_DELAY_LINE_MAX_CAPACITY - QX_DELAY_LINE_GUARD - max_delay)
+                return false;
+
+        size_t needed = max_delay + max_frames + QX_DELAY_LINE_GUARD;
+        uint32_t capacity = 1;
+        while (capacity < needed)
+                capacity <<= 1;
+
+        line->data = (float*)qx_simd_aligned_alloc(((size_t)capacity + QX_DELAY_LINE_GUARD) * sizeof(float));
+        if (!line->data)
+                return false;
+
+        line->capacity = capacity;
+        line->mask = capacity - 1;
+        memset(line->data, 0, ((size_t)capacity + QX_DELAY_LINE_GUARD) * sizeof(float));
+        return true;
+}
+
+/**
+ * @brief Release the memory of a delay line.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ */
+static inline void qx_delay_line_free(struct qx_delay_line* line)
+{
+        qx_simd_aligned_free(line->data);
+        line->data = NULL;
+        line->capacity = line->mask = line->write_pos = 0;
+}
+
+/**
+ * @brief Set all the delayed samples to zero.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ */
+static inline void qx_delay_line_clear(struct qx_delay_line* line)
+{
+        if (line->data)
+                memset(line->data, 0, ((size_t)line->capacity + QX_DELAY_LINE_GUARD) * sizeof(float));
+}
+
+/**
+ * @brief Write one sample and advance the write position.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param value Input sample.
+ */
+static inline void qx_delay_line_push(struct qx_delay_line* line, float value)
+{
+        uint32_t x = line->write_pos;
+        line->data[x + 1] = value;
+        if (x == line->mask)
+                line->data[0] = value;
+        else if (x < QX_DELAY_LINE_GUARD - 1)
+                line->data[line->capacity + 1 + x] = value;
+        line->write_pos = (x + 1) & line->mask;
+}
+
+/**
+ * @brief Split a delay into a masked base position and a weight.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param pos Logical position of the frame the delay is relative to.
+ * @param delay Delay in samples, non-negative.
+ * @param k Returned weight of the sample after the base.
+ * @return Storage index of the sample at the base position.
+ *
+ * The read position pos - delay lies between the base and base + 1.
+ */
+static inline uint32_t qx_delay_line_locate(const struct qx_delay_line* line,
+                                            uint32_t pos,
+                                            float delay,
+                                            float* k)
+{
+        uint32_t d = (uint32_t)delay;
+        *k = 1.0f - (delay - (float)d);
+        return ((pos - d - 1) & line->mask) + 1;
+}
+
+/**
+ * @brief Read the most recent samples with a linearly interpolated delay.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param delay Delay in samples relative to the last pushed sample.
+ * @return Delayed sample.
+ */
+static inline float qx_delay_line_tap(const struct qx_delay_line* line, float delay)
+{
+        float k;
+        const float* y = line->data + qx_delay_line_locate(line, line->write_pos - 1, delay, &k);
+        return y[0] + k * (y[1] - y[0]);
+}
+
+/**
+ * @brief Read the most recent samples with a Catmull-Rom interpolated delay.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param delay Delay in samples relative to the last pushed sample,
+ *              at least 1 (the 4-point kernel reads one sample ahead).
+ * @return Delayed sample.
+ */
+static inline float qx_delay_line_tap_hermite(const struct qx_delay_line* line, float delay)
+{
+        float k;
+        const float* y = line->data + qx_delay_line_locate(line, line->write_pos - 1, delay, &k);
+        return qx_interp_hermite4(y[-1], y[0], y[1], y[2], k);
+}
+
+/**
+ * @brief Write a block of samples without advancing the write position.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param in Input samples.
+ * @param frames Number of samples, at most max_frames.
+ *
+ * Follow with the block reads and then qx_delay_line_advance().
+ */
+static inline void qx_delay_line_write(struct qx_delay_line* line,
+                                       const float* in,
+                                       size_t frames)
+{
+        uint32_t x = line->write_pos;
+        size_t first = line->capacity - x;
+        if (first > frames)
+                first = frames;
+
+        memcpy(line->data + x + 1, in, first * sizeof(float));
+        memcpy(line->data + 1, in + first, (frames - first) * sizeof(float));
+
+        // Refresh the guard samples, cheaper than tracking what was touched
+        line->data[0] = line->data[line->capacity];
+        memcpy(line->data + line->capacity + 1, line->data + 1,
+               (QX_DELAY_LINE_GUARD - 1) * sizeof(float));
+}
+
+/**
+ * @brief Advance the write position after a block write.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param frames Number of samples written.
+ */
+static inline void qx_delay_line_advance(struct qx_delay_line* line, size_t frames)
+{
+        line->write_pos = (uint32_t)((line->write_pos + frames) & line->mask);
+}
+
+/**
+ * @brief Read a block with a modulated, linearly interpolated delay.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param delays Delay in samples for each frame, in [0, max_delay].
+ * @param out Output samples.
+ * @param frames Number of samples, at most max_frames.
+ *
+ * Frame j reads relative to the sample written at write_pos + j.
+ * Uses AVX2 gathers when available.
+ */
+static inline void qx_delay_line_read(const struct qx_delay_line* line,
+                                      const float* delays,
+                                      float* out,
+                                      size_t frames)
+{
+        const float* data = line->data;
+        size_t j = 0;
+#if defined(QX_SIMD_AVX2)
+        const __m256i vmask = _mm256_set1_epi32((int)line->mask);
+        const __m256i one = _mm256_set1_epi32(1);
+        __m256i pos = _mm256_add_epi32(_mm256_set1_epi32((int)line->write_pos),
+                                       _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        for (; j + 8 <= frames; j += 8) {
+                __m256 delay = _mm256_loadu_ps(delays + j);
+                __m256i d = _mm256_cvttps_epi32(delay);
+                __m256 k = _mm256_sub_ps(_mm256_set1_ps(1.0f),
+                                         _mm256_sub_ps(delay, _mm256_cvtepi32_ps(d)));
+                __m256i base = _mm256_add_epi32(_mm256_and_si256(_mm256_sub_epi32(_mm256_sub_epi32(pos, d), one),
+                                                                 vmask), one);
+                __m256 a = _mm256_i32gather_ps(data, base, 4);
+                __m256 b = _mm256_i32gather_ps(data + 1, base, 4);
+                _mm256_storeu_ps(out + j, _mm256_add_ps(a, _mm256_mul_ps(k, _mm256_sub_ps(b, a))));
+                pos = _mm256_add_epi32(pos, _mm256_set1_epi32(8));
+        }
+#endif
+        for (; j < frames; j++) {
+                float k;
+                const float* y = data + qx_delay_line_locate(line, line->write_pos + (uint32_t)j, delays[j], &k);
+                out[j] = y[0] + k * (y[1] - y[0]);
+        }
+}
+
+/**
+ * @brief Read a block with a modulated, Catmull-Rom interpolated delay.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param delays Delay in samples for each frame, in [1, max_delay].
+ * @param out Output samples.
+ * @param frames Number of samples, at most max_frames.
+ *
+ * Frame j reads relative to the sample written at write_pos + j.
+ * Uses AVX2 gathers when available.
+ */
+static inline void qx_delay_line_read_hermite(const struct qx_delay_line* line,
+                                              const float* delays,
+                                              float* out,
+                                              size_t frames)
+{
+        const float* data = line->data;
+        size_t j = 0;
+#if defined(QX_SIMD_AVX2)
+        const __m256i vmask = _mm256_set1_epi32((int)line->mask);
+        const __m256i one = _mm256_set1_epi32(1);
+        __m256i pos = _mm256_add_epi32(_mm256_set1_epi32((int)line->write_pos),
+                                       _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        for (; j + 8 <= frames; j += 8) {
+                __m256 delay = _mm256_loadu_ps(delays + j);
+                __m256i d = _mm256_cvttps_epi32(delay);
+                __m256 k = _mm256_sub_ps(_mm256_set1_ps(1.0f),
+                                         _mm256_sub_ps(delay, _mm256_cvtepi32_ps(d)));
+                __m256i base = _mm256_and_si256(_mm256_sub_epi32(_mm256_sub_epi32(pos, d), one), vmask);
+                __m256 ym1 = _mm256_i32gather_ps(data, base, 4);
+                __m256 y0 = _mm256_i32gather_ps(data + 1, base, 4);
+                __m256 y1 = _mm256_i32gather_ps(data + 2, base, 4);
+                __m256 y2 = _mm256_i32gather_ps(data + 3, base, 4);
+                _mm256_storeu_ps(out + j, qx_interp_hermite4_avx2(ym1, y0, y1, y2, k));
+                pos = _mm256_add_epi32(pos, _mm256_set1_epi32(8));
+        }
+#endif
+        for (; j < frames; j++) {
+                float k;
+                const float* y = data + qx_delay_line_locate(line, line->write_pos + (uint32_t)j, delays[j], &k);
+                out[j] = qx_interp_hermite4(y[-1], y[0], y[1], y[2], k);
+        }
+}
+
+/**
+ * @brief Read a block with a constant, linearly interpolated delay.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param delay Delay in samples, in [0, max_delay].
+ * @param out Output samples.
+ * @param frames Number of samples, at most max_frames.
+ *
+ * The source samples are contiguous apart from at most one wrap, so each
+ * run is a plain loop over adjacent memory the compiler can vectorize.
+ * An integer delay is a straight copy.
+ */
+static inline void qx_delay_line_read_fixed(const struct qx_delay_line* line,
+                                            float delay,
+                                            float* out,
+                                            size_t frames)
+{
+        float k;
+        uint32_t base = qx_delay_line_locate(line, line->write_pos, delay, &k);
+        while (frames > 0) {
+                size_t run = line->capacity + 1 - base;
+                if (run > frames)
+                        run = frames;
+
+                const float* y = line->data + base;
+                if (k == 1.0f) {
+                        memcpy(out, y + 1, run * sizeof(float));
+                } else {
+                        for (size_t j = 0; j < run; j++)
+                                out[j] = y[j] + k * (y[j + 1] - y[j]);
+                }
+
+                out += run;
+                frames -= run;
+                base = 1;
+        }
+}
+
+/**
+ * @brief Write a block, read it back through a modulated delay and advance.
+ *
+ * @param line Pointer to qx_delay_line struct.
+ * @param in Input samples.
+ * @param delays Delay in samples for each frame, in [0, max_delay].
+ * @param out Output samples, may alias in.
+ * @param frames Number of samples, at most max_frames.
+ */
+static inline void qx_delay_line_process(struct qx_delay_line* line,
+                                         const float* in,
+                                         const float* delays,
+                                         float* out,
+                                         size_t frames)
+{
+        qx_delay_line_write(line, in, frames);
+        qx_delay_line_read(line, delays, out, frames);
+        qx_delay_line_advance(line, frames);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_DELAY_LINE_H
@@ -0,0 +1,702 @@
+/**
+ * @file qx_distribution.h
+ * @brief Normal, exponential, triangular and table-driven samplers on qx_randomizer.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_DISTRIBUTION_H
+#define QX_DISTRIBUTION_H
+
+#include "qx_math.h"
+#include "qx_randomizer.h"
+#include "qx_simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Every sampler draws raw 32-bit values from a qx_randomizer, so it uses
+ * the same seeding and engine selection. The output range and resolution
+ * of the randomizer are not used.
+ *
+ * The block fills draw the raw values in chunks with qx_randomizer_fill_u32()
+ * and consume them in the same order as repeated single calls, so a fill
+ * of n values leaves the randomizer in the same state as n single calls.
+ */
+
+/**
+ * @brief Start of the tail of the normal ziggurat.
+ */
+#define QX_ZIGGURAT_R 3.442619855899f
+
+/*
+ * Ziggurat tables of the standard normal distribution, 128 layers
+ * (Marsaglia and Tsang, 2000) for a 25-bit signed candidate: kn holds the
+ * acceptance thresholds, wn the scale of each layer, fn the density at
+ * the layer edges.
+ */
+
+static const uint32_t qx_zig_kn[128] = {
+        0x0ed5a44u, 0x0000000u, 0x0c01e36u, 0x0d9c88fu, 0x0e4b68du, 0x0eac00au, 0x0ee9243u, 0x0f1344bu,
+        0x0f3208bu, 0x0f4979cu, 0x0f5bec5u, 0x0f6ad05u, 0x0f77151u, 0x0f815ceu, 0x0f8a199u, 0x0f919d8u,
+        0x0f98259u, 0x0f9ddfdu, 0x0fa2efcu, 0x0fa7711u, 0x0fab79cu, 0x0faf1bau, 0x0fb2651u, 0x0fb561cu,
+        0x0fb81bau, 0x0fba9adu, 0x0fbce63u, 0x0fbf039u, 0x0fc0f81u, 0x0fc2c7du, 0x0fc476bu, 0x0fc607bu,
+        0x0fc77ddu, 0x0fc8db6u, 0x0fca22au, 0x0fcb557u, 0x0fcc757u, 0x0fcd844u, 0x0fce832u, 0x0fcf734u,
+        0x0fd055bu, 0x0fd12b8u, 0x0fd1f58u, 0x0fd2b47u, 0x0fd3692u, 0x0fd4141u, 0x0fd4b60u, 0x0fd54f5u,
+        0x0fd5e09u, 0x0fd66a4u, 0x0fd6ecbu, 0x0fd7684u, 0x0fd7dd5u, 0x0fd84c4u, 0x0fd8b53u, 0x0fd9188u,
+        0x0fd9766u, 0x0fd9cf1u, 0x0fda22cu, 0x0fda71au, 0x0fdabbeu, 0x0fdb019u, 0x0fdb42eu, 0x0fdb800u,
+        0x0fdbb8fu, 0x0fdbeddu, 0x0fdc1ecu, 0x0fdc4bdu, 0x0fdc751u, 0x0fdc9a8u, 0x0fdcbc4u, 0x0fdcda5u,
+        0x0fdcf4cu, 0x0fdd0b8u, 0x0fdd1e9u, 0x0fdd2e0u, 0x0fdd39cu, 0x0fdd41du, 0x0fdd462u, 0x0fdd46au,
+        0x0fdd435u, 0x0fdd3c0u, 0x0fdd30cu, 0x0fdd215u, 0x0fdd0dau, 0x0fdcf58u, 0x0fdcd8eu, 0x0fdcb79u,
+        0x0fdc914u, 0x0fdc65du, 0x0fdc350u, 0x0fdbfe8u, 0x0fdbc1fu, 0x0fdb7f1u, 0x0fdb357u, 0x0fdae49u,
+        0x0fda8bfu, 0x0fda2b0u, 0x0fd9c12u, 0x0fd94d9u, 0x0fd8cf7u, 0x0fd845du, 0x0fd7afau, 0x0fd70b8u,
+        0x0fd6580u, 0x0fd5938u, 0x0fd4bbeu, 0x0fd3cedu, 0x0fd2c98u, 0x0fd1a89u, 0x0fd0680u, 0x0fcf02eu,
+        0x0fcd732u, 0x0fcbb14u, 0x0fc9b3bu, 0x0fc76e6u, 0x0fc4d18u, 0x0fc1c7fu, 0x0fbe354u, 0x0fb9f18u,
+        0x0fb4c34u, 0x0fae541u, 0x0fa61c1u, 0x0f9b369u, 0x0f8c01eu, 0x0f75217u, 0x0f4e442u, 0x0efacc9u,
+};
+
+static const float qx_zig_wn[128] = {
+        2.213171868e-07f, 1.623158841e-08f, 2.162882275e-08f, 2.542424121e-08f,
+        2.845751269e-08f, 3.103351824e-08f, 3.330064883e-08f, 3.534334555e-08f,
+        3.721467241e-08f, 3.895036213e-08f, 4.057573787e-08f, 4.210946627e-08f,
+        4.356574480e-08f, 4.495565083e-08f, 4.628801274e-08f, 4.756999377e-08f,
+        4.880749623e-08f, 5.000544872e-08f, 5.116801519e-08f, 5.229875023e-08f,
+        5.340071634e-08f, 5.447657412e-08f, 5.552865247e-08f, 5.655900392e-08f,
+        5.756944891e-08f, 5.856161139e-08f, 5.953694782e-08f, 6.049677105e-08f,
+        6.144227004e-08f, 6.237452631e-08f, 6.329452775e-08f, 6.420318037e-08f,
+        6.510131818e-08f, 6.598971173e-08f, 6.686907545e-08f, 6.774007392e-08f,
+        6.860332740e-08f, 6.945941664e-08f, 7.030888704e-08f, 7.115225243e-08f,
+        7.198999825e-08f, 7.282258454e-08f, 7.365044852e-08f, 7.447400687e-08f,
+        7.529365787e-08f, 7.610978327e-08f, 7.692274999e-08f, 7.773291171e-08f,
+        7.854061027e-08f, 7.934617696e-08f, 8.014993380e-08f, 8.095219459e-08f,
+        8.175326600e-08f, 8.255344854e-08f, 8.335303748e-08f, 8.415232375e-08f,
+        8.495159474e-08f, 8.575113515e-08f, 8.655122774e-08f, 8.735215410e-08f,
+        8.815419537e-08f, 8.895763301e-08f, 8.976274948e-08f, 9.056982903e-08f,
+        9.137915836e-08f, 9.219102739e-08f, 9.300573005e-08f, 9.382356501e-08f,
+        9.464483648e-08f, 9.546985508e-08f, 9.629893869e-08f, 9.713241336e-08f,
+        9.797061425e-08f, 9.881388670e-08f, 9.966258729e-08f, 1.005170850e-07f,
+        1.013777625e-07f, 1.022450173e-07f, 1.031192637e-07f, 1.040009337e-07f,
+        1.048904791e-07f, 1.057883737e-07f, 1.066951145e-07f, 1.076112249e-07f,
+        1.085372565e-07f, 1.094737923e-07f, 1.104214496e-07f, 1.113808835e-07f,
+        1.123527906e-07f, 1.133379133e-07f, 1.143370450e-07f, 1.153510349e-07f,
+        1.163807946e-07f, 1.174273050e-07f, 1.184916242e-07f, 1.195748967e-07f,
+        1.206783636e-07f, 1.218033753e-07f, 1.229514047e-07f, 1.241240643e-07f,
+        1.253231248e-07f, 1.265505379e-07f, 1.278084625e-07f, 1.290992972e-07f,
+        1.304257174e-07f, 1.317907219e-07f, 1.331976888e-07f, 1.346504434e-07f,
+        1.361533439e-07f, 1.377113869e-07f, 1.393303419e-07f, 1.410169226e-07f,
+        1.427790092e-07f, 1.446259407e-07f, 1.465689050e-07f, 1.486214711e-07f,
+        1.508003278e-07f, 1.531263367e-07f, 1.556260734e-07f, 1.583341605e-07f,
+        1.612969382e-07f, 1.645785196e-07f, 1.682713837e-07f, 1.725163464e-07f,
+        1.775441320e-07f, 1.837747609e-07f, 1.921108356e-07f, 2.051961336e-07f,
+};
+
+static const float qx_zig_fn[128] = {
+        1.000000000e+00f, 9.635996931e-01f, 9.362826817e-01f, 9.130436480e-01f,
+        8.922816508e-01f, 8.732430489e-01f, 8.555006079e-01f, 8.387836053e-01f,
+        8.229072114e-01f, 8.077382947e-01f, 7.931770118e-01f, 7.791460859e-01f,
+        7.655841739e-01f, 7.524415592e-01f, 7.396772437e-01f, 7.272569183e-01f,
+        7.151515074e-01f, 7.033360990e-01f, 6.917891434e-01f, 6.804918410e-01f,
+        6.694276673e-01f, 6.585820001e-01f, 6.479418211e-01f, 6.374954773e-01f,
+        6.272324852e-01f, 6.171433708e-01f, 6.072195366e-01f, 5.974531509e-01f,
+        5.878370544e-01f, 5.783646811e-01f, 5.690299911e-01f, 5.598274127e-01f,
+        5.507517931e-01f, 5.417983550e-01f, 5.329626594e-01f, 5.242405727e-01f,
+        5.156282382e-01f, 5.071220511e-01f, 4.987186355e-01f, 4.904148253e-01f,
+        4.822076463e-01f, 4.740943007e-01f, 4.660721527e-01f, 4.581387163e-01f,
+        4.502916437e-01f, 4.425287153e-01f, 4.348478302e-01f, 4.272469983e-01f,
+        4.197243320e-01f, 4.122780401e-01f, 4.049064208e-01f, 3.976078565e-01f,
+        3.903808082e-01f, 3.832238111e-01f, 3.761354695e-01f, 3.691144537e-01f,
+        3.621594954e-01f, 3.552693848e-01f, 3.484429675e-01f, 3.416791412e-01f,
+        3.349768533e-01f, 3.283350984e-01f, 3.217529159e-01f, 3.152293881e-01f,
+        3.087636380e-01f, 3.023548278e-01f, 2.960021568e-01f, 2.897048604e-01f,
+        2.834622082e-01f, 2.772735029e-01f, 2.711380791e-01f, 2.650553023e-01f,
+        2.590245674e-01f, 2.530452985e-01f, 2.471169475e-01f, 2.412389935e-01f,
+        2.354109423e-01f, 2.296323252e-01f, 2.239026994e-01f, 2.182216466e-01f,
+        2.125887731e-01f, 2.070037094e-01f, 2.014661101e-01f, 1.959756531e-01f,
+        1.905320403e-01f, 1.851349970e-01f, 1.797842721e-01f, 1.744796383e-01f,
+        1.692208922e-01f, 1.640078547e-01f, 1.588403711e-01f, 1.537183122e-01f,
+        1.486415742e-01f, 1.436100801e-01f, 1.386237800e-01f, 1.336826526e-01f,
+        1.287867062e-01f, 1.239359802e-01f, 1.191305467e-01f, 1.143705124e-01f,
+        1.096560210e-01f, 1.049872554e-01f, 1.003644410e-01f, 9.578784912e-02f,
+        9.125780083e-02f, 8.677467189e-02f, 8.233889824e-02f, 7.795098251e-02f,
+        7.361150188e-02f, 6.932111739e-02f, 6.508058521e-02f, 6.089077035e-02f,
+        5.675266348e-02f, 5.266740190e-02f, 4.863629586e-02f, 4.466086220e-02f,
+        4.074286807e-02f, 3.688438879e-02f, 3.308788615e-02f, 2.935631744e-02f,
+        2.569329194e-02f, 2.210330462e-02f, 1.859210274e-02f, 1.516729801e-02f,
+        1.183947866e-02f, 8.624484413e-03f, 5.548995221e-03f, 2.669629084e-03f,
+};
+
+/**
+ * @brief Source of raw values for the samplers.
+ *
+ * Reads the randomizer directly when `buf` is NULL, otherwise from a
+ * buffer refilled with at most `remaining` values, the number of outputs
+ * still to produce. Every output draws at least one value, so a block
+ * fill never advances the randomizer past what it consumed.
+ */
+struct qx_dist_source {
+        struct qx_randomizer* rand;
+        uint32_t* buf;
+        size_t pos;
+        size_t len;
+        size_t remaining;
+};
+
+static inline uint32_t qx_dist_source_next(struct qx_dist_source* src)
+{
+        if (!src->buf)
+                return qx_randomizer_next_u32(src->rand);
+
+        if (src->pos == src->len) {
+                src->len = src->remaining < QX_RANDOMIZER_CHUNK ? src->remaining : QX_RANDOMIZER_CHUNK;
+                src->pos = 0;
+                qx_randomizer_fill_u32(src->rand, src->buf, src->len);
+        }
+        return src->buf[src->pos++];
+}
+
+/**
+ * @brief Map a raw value to a uniform float in [0, 1).
+ *
+ * Uses the 24 high bits.
+ */
+static inline float qx_dist_uniform(uint32_t u)
+{
+        return (float)(u >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Map a raw value to a uniform float in (0, 1].
+ */
+static inline float qx_dist_uniform_open(uint32_t u)
+{
+        return (float)((u >> 8) + 1) * (1.0f / 16777216.0f);
+}
+
+static inline float qx_dist_normal_from(struct qx_dist_source* src)
+{
+        for (;;) {
+                // Layer from the 7 high bits, signed candidate from the 25 low bits
+                uint32_t u = qx_dist_source_next(src);
+                uint32_t iz = u >> 25;
+                int32_t hz = (int32_t)(u << 7) >> 7;
+                uint32_t ahz = hz < 0 ? (uint32_t)-hz : (uint32_t)hz;
+                float x = (float)hz * qx_zig_wn[iz];
+                if (ahz < qx_zig_kn[iz])
+                        return x;
+
+                if (iz == 0) {
+                        // Tail beyond R (Marsaglia, 1964)
+                        float xt, y;
+                        do {
+                                xt = -logf(qx_dist_uniform_open(qx_dist_source_next(src))) * (1.0f / QX_ZIGGURAT_R);
+                                y = -logf(qx_dist_uniform_open(qx_dist_source_next(src)));
+                        } while (y + y < xt * xt);
+                        return hz > 0 ? QX_ZIGGURAT_R + xt : -QX_ZIGGURAT_R - xt;
+                }
+
+                // Wedge between the layer and the density
+                float v = qx_dist_uniform(qx_dist_source_next(src));
+                if (qx_zig_fn[iz] + v * (qx_zig_fn[iz - 1] - qx_zig_fn[iz]) < expf(-0.5f * x * x))
+                        return x;
+        }
+}
+
+/**
+ * @brief Normally distributed value (ziggurat).
+ *
+ * About 98.8% of the values cost one raw value, a shift, two table reads
+ * and a compare; the rest fall back to expf()/logf().
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param mean Mean.
+ * @param stddev Standard deviation.
+ * @return mean + stddev * N(0, 1).
+ */
+static inline float qx_dist_normal(struct qx_randomizer* rand, float mean, float stddev)
+{
+        struct qx_dist_source src = { rand, NULL, 0, 0, 0 };
+        return mean + stddev * qx_dist_normal_from(&src);
+}
+
+/**
+ * @brief Fill a buffer with normally distributed values.
+ *
+ * Same values as calling qx_dist_normal() `n` times.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param mean Mean.
+ * @param stddev Standard deviation.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_dist_normal_fill(struct qx_randomizer* rand,
+                                       float mean,
+                                       float stddev,
+                                       float* out,
+                                       size_t n)
+{
+        uint32_t buf[QX_RANDOMIZER_CHUNK];
+        struct qx_dist_source src = { rand, buf, 0, 0, n };
+        for (size_t i = 0; i < n; i++, src.remaining--)
+                out[i] = mean + stddev * qx_dist_normal_from(&src);
+}
+
+/*
+ * Vector conversions of raw values for the exponential and triangular
+ * fills, same operations as the scalar code.
+ */
+#if defined(QX_SIMD_AVX2)
+static inline __m256 qx_dist_uniform_avx2(__m256i u, int open)
+{
+        __m256i v = _mm256_add_epi32(_mm256_srli_epi32(u, 8), _mm256_set1_epi32(open));
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+#elif defined(QX_SIMD_SSE2)
+static inline __m128 qx_dist_uniform_sse2(__m128i u, int open)
+{
+        __m128i v = _mm_add_epi32(_mm_srli_epi32(u, 8), _mm_set1_epi32(open));
+        return _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 16777216.0f));
+}
+#elif defined(QX_SIMD_NEON)
+static inline float32x4_t qx_dist_uniform_neon(uint32x4_t u, int open)
+{
+        uint32x4_t v = vaddq_u32(vshrq_n_u32(u, 8), vdupq_n_u32((uint32_t)open));
+        return vmulq_n_f32(vcvtq_f32_u32(v), 1.0f / 16777216.0f);
+}
+#endif
+
+/**
+ * @brief Exponentially distributed value.
+ *
+ * Inverse CDF -ln(u) / rate with qx_fast_log2f(); u has 24 bits, so the
+ * values are limited to 16.6 / rate.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param rate Rate (inverse of the mean), must be positive.
+ * @return A value >= 0.
+ */
+static inline float qx_dist_exponential(struct qx_randomizer* rand, float rate)
+{
+        float scale = -0.6931471806f / rate;
+        return qx_fast_log2f(qx_dist_uniform_open(qx_randomizer_next_u32(rand))) * scale;
+}
+
+/**
+ * @brief Fill a buffer with exponentially distributed values.
+ *
+ * Consumes the same raw values as calling qx_dist_exponential() `n` times;
+ * the vector logarithm matches the scalar one to float rounding.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param rate Rate (inverse of the mean), must be positive.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_dist_exponential_fill(struct qx_randomizer* rand,
+                                            float rate,
+                                            float* out,
+                                            size_t n)
+{
+        float scale = -0.6931471806f / rate;
+        uint32_t raw[QX_RANDOMIZER_CHUNK];
+        for (size_t pos = 0; pos < n; pos += QX_RANDOMIZER_CHUNK) {
+                size_t count = n - pos;
+                if (count > QX_RANDOMIZER_CHUNK)
+                        count = QX_RANDOMIZER_CHUNK;
+                qx_randomizer_fill_u32(rand, raw, count);
+
+                float* dst = out + pos;
+                size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= count; i += 8) {
+                        __m256 u = qx_dist_uniform_avx2(_mm256_loadu_si256((const __m256i*)(raw + i)), 1);
+                        _mm256_storeu_ps(dst + i, _mm256_mul_ps(qx_fast_log2_avx2(u), _mm256_set1_ps(scale)));
+                }
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= count; i += 4) {
+                        __m128 u = qx_dist_uniform_sse2(_mm_loadu_si128((const __m128i*)(raw + i)), 1);
+                        _mm_storeu_ps(dst + i, _mm_mul_ps(qx_fast_log2_sse2(u), _mm_set1_ps(scale)));
+                }
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= count; i += 4) {
+                        float32x4_t u = qx_dist_uniform_neon(vld1q_u32(raw + i), 1);
+                        vst1q_f32(dst + i, vmulq_n_f32(qx_fast_log2_neon(u), scale));
+                }
+#endif
+                for (; i < count; i++)
+                        dst[i] = qx_fast_log2f(qx_dist_uniform_open(raw[i])) * scale;
+        }
+}
+
+/**
+ * @brief Triangular distributed value, the mean of two uniform values.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param min Lower bound.
+ * @param max Upper bound; the mode is (min + max) / 2.
+ * @return A value in [min, max).
+ */
+static inline float qx_dist_triangular(struct qx_randomizer* rand, float min, float max)
+{
+        float half = 0.5f * (max - min);
+        float a = qx_dist_uniform(qx_randomizer_next_u32(rand));
+        float b = qx_dist_uniform(qx_randomizer_next_u32(rand));
+        return min + half * (a + b);
+}
+
+/**
+ * @brief Fill a buffer with triangular distributed values.
+ *
+ * Same values as calling qx_dist_triangular() `n` times.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param min Lower bound.
+ * @param max Upper bound.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_dist_triangular_fill(struct qx_randomizer* rand,
+                                           float min,
+                                           float max,
+                                           float* out,
+                                           size_t n)
+{
+        enum { chunk = QX_RANDOMIZER_CHUNK / 2 };
+        float half = 0.5f * (max - min);
+        uint32_t raw[QX_RANDOMIZER_CHUNK];
+        float u[QX_RANDOMIZER_CHUNK];
+        for (size_t pos = 0; pos < n; pos += chunk) {
+                size_t count = n - pos;
+                if (count > chunk)
+                        count = chunk;
+                qx_randomizer_fill_u32(rand, raw, 2 * count);
+
+                size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= 2 * count; i += 8)
+                        _mm256_storeu_ps(u + i, qx_dist_uniform_avx2(_mm256_loadu_si256((const __m256i*)(raw + i)), 0));
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= 2 * count; i += 4)
+                        _mm_storeu_ps(u + i, qx_dist_uniform_sse2(_mm_loadu_si128((const __m128i*)(raw + i)), 0));
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= 2 * count; i += 4)
+                        vst1q_f32(u + i, qx_dist_uniform_neon(vld1q_u32(raw + i), 0));
+#endif
+                for (; i < 2 * count; i++)
+                        u[i] = qx_dist_uniform(raw[i]);
+
+                float* dst = out + pos;
+                for (size_t j = 0; j < count; j++)
+                        dst[j] = min + half * (u[2 * j] + u[2 * j + 1]);
+        }
+}
+
+/**
+ * @brief Table-driven inverse CDF of an arbitrary distribution.
+ *
+ * Holds the quantiles at p = j / 2^bits for j in [0, 2^bits]. A sample
+ * takes the table index from the high bits of a raw value and, for
+ * continuous distributions, interpolates linearly with the next bits.
+ */
+struct qx_icdf_table {
+        float* values;   /**< 2^bits + 1 quantiles */
+        uint32_t bits;   /**< log2 of the number of intervals */
+        bool discrete;   /**< No interpolation, the values are the outcomes */
+};
+
+/** Maximum number of index bits of an inverse CDF table. */
+#define QX_ICDF_MAX_BITS 20
+
+static inline bool qx_icdf_table_alloc(struct qx_icdf_table* table, int bits, bool discrete)
+{
+        table->values = NULL;
+        table->bits = 0;
+        table->discrete = discrete;
+        if (bits < 1 || bits > QX_ICDF_MAX_BITS)
+                return false;
+
+        table->values = (float*)qx_simd_aligned_alloc((((size_t)1 << bits) + 1) * sizeof(float));
+        if (!table->values)
+                return false;
+
+        table->bits = (uint32_t)bits;
+        return true;
+}
+
+/**
+ * @brief Build an inverse CDF table from a sampled density.
+ *
+ * The density is linear between the samples; the quantiles are exact
+ * for that piecewise linear density.
+ *
+ * @param table Pointer to qx_icdf_table struct.
+ * @param pdf Density (not necessarily normalized) at n points evenly spaced over [lo, hi].
+ * @param n Number of density samples, at least 2.
+ * @param lo Lower bound of the distribution.
+ * @param hi Upper bound of the distribution.
+ * @param bits log2 of the number of table intervals, in [1, QX_ICDF_MAX_BITS], e.g. 10.
+ * @return true on success, false on invalid arguments, a density without mass,
+ *         or if memory allocation failed.
+ *
+ * The table must be released with qx_icdf_table_free().
+ */
+static inline bool qx_icdf_table_init_pdf(struct qx_icdf_table* table,
+                                          const float* pdf,
+                                          size_t n,
+                                          float lo,
+                                          float hi,
+                                          int bits)
+{
+        if (n < 2 || !qx_icdf_table_alloc(table, bits, false))
+                return false;
+
+        double* cdf = (double*)malloc(n * sizeof(double));
+        if (!cdf) {
+                qx_simd_aligned_free(table->values);
+                table->values = NULL;
+                table->bits = 0;
+                return false;
+        }
+
+        double h = ((double)hi - lo) / (double)(n - 1);
+        cdf[0] = 0.0;
+        for (size_t i = 1; i < n; i++)
+                cdf[i] = cdf[i - 1] + 0.5 * h * ((double)pdf[i - 1] + pdf[i]);
+
+        double total = cdf[n - 1];
+        if (!(total > 0.0)) {
+                free(cdf);
+                qx_simd_aligned_free(table->values);
+                table->values = NULL;
+                table->bits = 0;
+                return false;
+        }
+
+        size_t size = (size_t)1 << bits;
+        size_t c = 0;
+        for (size_t j = 0; j <= size; j++) {
+                double target = total * (double)j / (double)size;
+                // First cell whose end reaches the target, skipping cells without mass
+                while (c + 2 < n && (cdf[c + 1] < target || (j == 0 && cdf[c + 1] <= 0.0)))
+                        c++;
+
+                // Solve f0 t + (f1 - f0) t^2 / (2 h) = target - cdf[c] for t in [0, h]
+                double f0 = pdf[c];
+                double a = ((double)pdf[c + 1] - f0) / (2.0 * h);
+                double r = target - cdf[c];
+                if (r < 0.0)
+                        r = 0.0;
+                double disc = f0 * f0 + 4.0 * a * r;
+                double den = f0 + sqrt(disc > 0.0 ? disc : 0.0);
+                double t = den > 0.0 ? 2.0 * r / den : 0.0;
+                if (t > h)
+                        t = h;
+                table->values[j] = (float)(lo + (double)c * h + t);
+        }
+
+        free(cdf);
+        return true;
+}
+
+/**
+ * @brief Build an inverse CDF table of a discrete distribution.
+ *
+ * The outcomes are 0, 1, ..., n - 1. Each probability is quantized to a
+ * multiple of 2^-bits (the midpoint of every table interval picks its
+ * outcome), so outcomes rarer than that may never occur.
+ *
+ * @param table Pointer to qx_icdf_table struct.
+ * @param pmf Probability (not necessarily normalized) of each outcome.
+ * @param n Number of outcomes.
+ * @param bits log2 of the number of table intervals, in [1, QX_ICDF_MAX_BITS], e.g. 12.
+ * @return true on success, false on invalid arguments or if memory allocation failed.
+ *
+ * The table must be released with qx_icdf_table_free().
+ */
+static inline bool qx_icdf_table_init_discrete(struct qx_icdf_table* table,
+                                               const float* pmf,
+                                               size_t n,
+                                               int bits)
+{
+        if (n < 1 || !qx_icdf_table_alloc(table, bits, true))
+                return false;
+
+        double total = 0.0;
+        for (size_t k = 0; k < n; k++)
+                total += pmf[k];
+
+        size_t size = (size_t)1 << bits;
+        size_t k = 0;
+        double cdf = pmf[0];
+        for (size_t j = 0; j < size; j++) {
+                double target = total * ((double)j + 0.5) / (double)size;
+                while (k + 1 < n && cdf <= target)
+                        cdf += pmf[++k];
+                table->values[j] = (float)k;
+        }
+        table->values[size] = table->values[size - 1];
+        return true;
+}
+
+/**
+ * @brief Build an inverse CDF table of the Poisson distribution.
+ *
+ * For event counts, e.g. the number of grains or clicks per block.
+ * The outcomes cover the probability mass up to 1 - 1e-9.
+ *
+ * @param table Pointer to qx_icdf_table struct.
+ * @param lambda Mean number of events, in (0, 1000].
+ * @param bits log2 of the number of table intervals, in [1, QX_ICDF_MAX_BITS], e.g. 12.
+ * @return true on success, false on invalid arguments or if memory allocation failed.
+ *
+ * The table must be released with qx_icdf_table_free().
+ */
+static inline bool qx_icdf_table_init_poisson(struct qx_icdf_table* table, float lambda, int bits)
+{
+        if (!(lambda > 0.0f) || lambda > 1000.0f)
+                return false;
+
+        size_t n = (size_t)(lambda + 12.0f * sqrtf(lambda)) + 16;
+        float* pmf = (float*)malloc(n * sizeof(float));
+        if (!pmf)
+                return false;
+
+        // p(k) = p(k - 1) * lambda / k, from the log of p(0) to avoid underflow
+        double log_p = -(double)lambda;
+        double sum = 0.0;
+        size_t count = 0;
+        for (size_t k = 0; k < n; k++) {
+                if (k > 0)
+                        log_p += log((double)lambda / (double)k);
+                pmf[k] = (float)exp(log_p);
+                sum += pmf[k];
+                count = k + 1;
+                if ((double)k > lambda && sum >= 1.0 - 1e-9)
+                        break;
+        }
+
+        bool ok = qx_icdf_table_init_discrete(table, pmf, count, bits);
+        free(pmf);
+        return ok;
+}
+
+/**
+ * @brief Release the memory of an inverse CDF table.
+ *
+ * @param table Pointer to qx_icdf_table struct.
+ */
+static inline void qx_icdf_table_free(struct qx_icdf_table* table)
+{
+        qx_simd_aligned_free(table->values);
+        table->values = NULL;
+        table->bits = 0;
+}
+
+/**
+ * @brief Map a raw value through an inverse CDF table.
+ *
+ * @param table Initialized table.
+ * @param u Raw 32-bit value.
+ * @return The sampled value.
+ */
+static inline float qx_icdf_table_map(const struct qx_icdf_table* table, uint32_t u)
+{
+        uint32_t j = u >> (32 - table->bits);
+        float y0 = table->values[j];
+        if (table->discrete)
+                return y0;
+
+        float k = (float)((u << table->bits) >> 8) * (1.0f / 16777216.0f);
+        return y0 + k * (table->values[j + 1] - y0);
+}
+
+/**
+ * @brief Value distributed according to an inverse CDF table.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param table Initialized table.
+ * @return The sampled value.
+ */
+static inline float qx_dist_icdf(struct qx_randomizer* rand, const struct qx_icdf_table* table)
+{
+        return qx_icdf_table_map(table, qx_randomizer_next_u32(rand));
+}
+
+/**
+ * @brief Fill a buffer with values distributed according to an inverse CDF table.
+ *
+ * Same values as calling qx_dist_icdf() `n` times. With AVX2 the table
+ * reads are gathers.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param table Initialized table.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_dist_icdf_fill(struct qx_randomizer* rand,
+                                     const struct qx_icdf_table* table,
+                                     float* out,
+                                     size_t n)
+{
+        uint32_t raw[QX_RANDOMIZER_CHUNK];
+        for (size_t pos = 0; pos < n; pos += QX_RANDOMIZER_CHUNK) {
+                size_t count = n - pos;
+                if (count > QX_RANDOMIZER_CHUNK)
+                        count = QX_RANDOMIZER_CHUNK;
+                qx_randomizer_fill_u32(rand, raw, count);
+
+                float* dst = out + pos;
+                size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+                const __m128i shift = _mm_cvtsi32_si128((int)(32 - table->bits));
+                const __m128i bits = _mm_cvtsi32_si128((int)table->bits);
+                for (; i + 8 <= count; i += 8) {
+                        __m256i u = _mm256_loadu_si256((const __m256i*)(raw + i));
+                        __m256i j = _mm256_srl_epi32(u, shift);
+                        __m256 y0 = _mm256_i32gather_ps(table->values, j, 4);
+                        if (table->discrete) {
+                                _mm256_storeu_ps(dst + i, y0);
+                                continue;
+                        }
+                        __m256 y1 = _mm256_i32gather_ps(table->values + 1, j, 4);
+                        __m256i m = _mm256_srli_epi32(_mm256_sll_epi32(u, bits), 8);
+                        __m256 k = _mm256_mul_ps(_mm256_cvtepi32_ps(m), _mm256_set1_ps(1.0f / 16777216.0f));
+                        _mm256_storeu_ps(dst + i, _mm256_add_ps(y0, _mm256_mul_ps(k, _mm256_sub_ps(y1, y0))));
+                }
+#endif
+                for (; i < count; i++)
+                        dst[i] = qx_icdf_table_map(table, raw[i]);
+        }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QX_DISTRIBUTION_H
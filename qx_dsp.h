@@ -0,0 +1,236 @@
+/**
+ * @file qx_dsp.h
+ * @brief Runtime CPU dispatch of the qx_* block kernels.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_DSP_H
+#define QX_DSP_H
+
+#include "qx_fader.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(QX_DSP_BUILD_SHARED)
+#  if defined(_WIN32)
+#    define QX_DSP_API __declspec(dllexport)
+#  else
+#    define QX_DSP_API __attribute__((visibility("default")))
+#  endif
+#elif defined(QX_DSP_SHARED) && defined(_WIN32)
+#  define QX_DSP_API __declspec(dllimport)
+#else
+#  define QX_DSP_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The qx_* headers pick their SIMD code paths at compile time. An
+ * application that ships one binary to different CPUs links the compiled
+ * dispatch library instead (sources in the src directory): every block
+ * kernel is built once per instruction set, and qx_dsp() returns the table
+ * for the best one the CPU supports. The table is selected on first use
+ * or by qx_dsp_init(); qx_dsp_set_isa() forces a specific one.
+ *
+ * The kernels take the same structs and arguments as the inline header
+ * functions they wrap, so state can be created with the header functions
+ * and processed through the table.
+ */
+
+struct qx_fader;
+struct qx_fader_bank;
+struct qx_crossfader;
+struct qx_smoother;
+struct qx_smoother_bank;
+struct qx_randomizer;
+struct qx_random_engine;
+struct qx_icdf_table;
+struct qx_noise;
+struct qx_sinc_table;
+struct qx_delay_line;
+
+/**
+ * @brief Instruction sets with a kernel table.
+ */
+enum qx_dsp_isa {
+        QX_DSP_ISA_SCALAR = 0,
+        QX_DSP_ISA_SSE2,
+        QX_DSP_ISA_AVX,
+        QX_DSP_ISA_AVX2,
+        QX_DSP_ISA_AVX512,
+        QX_DSP_ISA_NEON,
+        QX_DSP_ISA_COUNT
+};
+
+/**
+ * @brief Block kernels compiled for one instruction set.
+ *
+ * Each member has the signature of the header function of the same name
+ * without the qx_ prefix, e.g. fader_process_block is qx_fader_process_block().
+ */
+struct qx_dsp_kernels {
+        enum qx_dsp_isa isa;
+
+        /* qx_simd.h */
+        void (*simd_ramp_fill)(float* out, size_t n, float start, float delta, float lo, float hi);
+        void (*simd_ramp_mul)(const float* in, float* out, size_t n,
+                              float start, float delta, float lo, float hi);
+        void (*simd_mul)(const float* a, const float* b, float* out, size_t n);
+        void (*simd_scale)(const float* in, float* out, size_t n, float gain);
+        void (*simd_mix)(const float* a, const float* ga, const float* b, const float* gb,
+                         float* out, size_t n);
+        void (*simd_mix_gain)(const float* a, const float* b, float* out, size_t n, float ga, float gb);
+
+        /* qx_fader.h */
+        void (*fader_process_block)(struct qx_fader* fader, float* buf, size_t frames);
+        void (*fader_process_block_out)(struct qx_fader* fader, const float* in, float* out, size_t frames);
+        size_t (*fader_process_block_end)(struct qx_fader* fader, float* buf, size_t frames);
+        size_t (*fader_process_block_end_out)(struct qx_fader* fader, const float* in, float* out, size_t frames);
+        void (*fader_process_interleaved)(struct qx_fader* fader, float* buf, size_t frames, size_t channels);
+        void (*fader_process_interleaved_out)(struct qx_fader* fader, const float* in, float* out,
+                                              size_t frames, size_t channels);
+        void (*fader_bank_advance)(struct qx_fader_bank* bank, size_t frames);
+        void (*fader_bank_set_time)(struct qx_fader_bank* bank, float fadeTime);
+        void (*fader_bank_set_sample_rate)(struct qx_fader_bank* bank, float sample_rate);
+        void (*fader_bank_process)(struct qx_fader_bank* bank, float* const* bufs, size_t frames);
+        void (*fader_curve_array)(enum qx_fader_curve curve, const float* in, float* out, size_t n);
+
+        /* qx_crossfader.h */
+        void (*crossfader_process_block)(struct qx_crossfader* xf, const float* a, const float* b,
+                                         float* out, size_t frames);
+
+        /* qx_smoother.h */
+        void (*smoother_process_block)(struct qx_smoother* s, float* out, size_t frames);
+        void (*smoother_apply_gain_block)(struct qx_smoother* s, const float* in, float* out, size_t frames);
+        void (*smoother_bank_process)(struct qx_smoother_bank* bank, float* const* outs, size_t frames);
+
+        /* qx_randomizer.h, qx_random_engine.h */
+        void (*randomizer_fill)(struct qx_randomizer* rand, float* out, size_t n);
+        void (*randomizer_fill_at)(const struct qx_randomizer* rand, uint64_t key, uint64_t counter,
+                                   float* out, size_t n);
+        void (*random_engine_fill_u32)(struct qx_random_engine* eng, uint32_t* out, size_t n);
+        void (*random_fill_at)(uint64_t key, uint64_t counter, uint32_t* out, size_t n);
+        void (*randomizer_fill_u32)(struct qx_randomizer* rand, uint32_t* out, size_t n);
+
+        /* qx_distribution.h */
+        void (*dist_normal_fill)(struct qx_randomizer* rand, float mean, float stddev, float* out, size_t n);
+        void (*dist_exponential_fill)(struct qx_randomizer* rand, float rate, float* out, size_t n);
+        void (*dist_triangular_fill)(struct qx_randomizer* rand, float min, float max, float* out, size_t n);
+        void (*dist_icdf_fill)(struct qx_randomizer* rand, const struct qx_icdf_table* table,
+                               float* out, size_t n);
+
+        /* qx_noise.h */
+        void (*noise_fill)(struct qx_noise* noise, float* out, size_t n);
+
+        /* qx_math.h */
+        void (*normalize_array_float)(const float* in, float* out, size_t n, float min, float max);
+        void (*normalize_clamp_array_float)(const float* in, float* out, size_t n, float min, float max);
+        void (*denormalize_array_float)(const float* in, float* out, size_t n, float min, float max);
+        void (*denormalize_clamp_array_float)(const float* in, float* out, size_t n, float min, float max);
+        void (*clamp_array_float)(const float* in, float* out, size_t n, float min, float max);
+        void (*normalize_array_double)(const double* in, double* out, size_t n, double min, double max);
+        void (*normalize_clamp_array_double)(const double* in, double* out, size_t n, double min, double max);
+        void (*denormalize_array_double)(const double* in, double* out, size_t n, double min, double max);
+        void (*denormalize_clamp_array_double)(const double* in, double* out, size_t n, double min, double max);
+        void (*clamp_array_double)(const double* in, double* out, size_t n, double min, double max);
+        void (*db_to_val_array)(const float* db, float* val, size_t n);
+        void (*val_to_db_array)(const float* val, float* db, size_t n);
+        void (*wrapf_array)(const float* in, float* out, size_t n, float max);
+        void (*phase_fill)(float* phase, float inc, float* out, size_t n);
+
+        /* qx_interp.h */
+        void (*ring_read_linear_block)(const float* buf, int size, const float* index, float* out, size_t n);
+        void (*ring_read_hermite_block)(const float* buf, int size, const float* index, float* out, size_t n);
+        void (*ring_read_lagrange4_block)(const float* buf, int size, const float* index, float* out, size_t n);
+        void (*ring_read_sinc_block)(const struct qx_sinc_table* table, const float* buf, int size,
+                                     const float* index, float* out, size_t n);
+
+        /* qx_delay_line.h */
+        void (*delay_line_read)(const struct qx_delay_line* line, const float* delays, float* out, size_t frames);
+        void (*delay_line_read_hermite)(const struct qx_delay_line* line, const float* delays,
+                                        float* out, size_t frames);
+        void (*delay_line_read_fixed)(const struct qx_delay_line* line, float delay, float* out, size_t frames);
+        void (*delay_line_process)(struct qx_delay_line* line, const float* in, const float* delays,
+                                   float* out, size_t frames);
+};
+
+/**
+ * @brief Detect the CPU features and select the best kernel table.
+ *
+ * Called automatically by the first qx_dsp(). Calling it explicitly at
+ * startup keeps the detection off the audio thread. If the environment
+ * variable QX_DSP_ISA names a supported instruction set ("scalar", "sse2",
+ * "avx", "avx2", "avx512", "neon") that one is selected instead.
+ */
+QX_DSP_API void qx_dsp_init(void);
+
+/**
+ * @brief Get the selected kernel table.
+ *
+ * @return Pointer to the kernel table, never NULL.
+ */
+QX_DSP_API const struct qx_dsp_kernels* qx_dsp(void);
+
+/**
+ * @brief Check whether an instruction set is compiled in and supported by the CPU.
+ *
+ * @param isa Instruction set.
+ * @return true if qx_dsp_set_isa() would accept it.
+ */
+QX_DSP_API bool qx_dsp_isa_supported(enum qx_dsp_isa isa);
+
+/**
+ * @brief Force the kernel table of an instruction set.
+ *
+ * Meant for tests and benchmarks comparing the code paths.
+ *
+ * @param isa Instruction set.
+ * @return false, leaving the selection unchanged, if it is not supported.
+ */
+QX_DSP_API bool qx_dsp_set_isa(enum qx_dsp_isa isa);
+
+/**
+ * @brief Get the instruction set of the selected kernel table.
+ *
+ * @return Selected instruction set.
+ */
+QX_DSP_API enum qx_dsp_isa qx_dsp_get_isa(void);
+
+/**
+ * @brief Get the name of an instruction set.
+ *
+ * @param isa Instruction set.
+ * @return Lower case name, e.g. "avx2", or "unknown".
+ */
+QX_DSP_API const char* qx_dsp_isa_name(enum qx_dsp_isa isa);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_DSP_H
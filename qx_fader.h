@@ -28,15 +28,54 @@
 #define QX_FADER_H
 
 #include "qx_math.h"
+#include "qx_simd.h"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Gain curves of the fader.
+ *
+ * The fade value always moves linearly; the curve maps it to the applied
+ * gain. Every curve maps 0 to 0 and 1 to 1, and a fade-out runs the curve
+ * backwards, so a fader fading in and one fading out with the equal-power
+ * curve form an equal-power crossfade.
+ */
+enum qx_fader_curve {
+        /** gain = x */
+        QX_FADER_CURVE_LINEAR = 0,
+        /** gain = sin(pi/2 x), the fade-out is a cosine; equal power */
+        QX_FADER_CURVE_EQUAL_POWER,
+        /** gain = (1001^x - 1) / 1000, a 60 dB rise, linear in dB above silence */
+        QX_FADER_CURVE_EXPONENTIAL,
+        /** gain = 1 - exponential(1 - x), fast rise and slow settle */
+        QX_FADER_CURVE_LOGARITHMIC,
+        /** gain = (1 - cos(pi x)) / 2, S-shaped */
+        QX_FADER_CURVE_RAISED_COSINE,
+};
+
+/**
+ * @brief Progress of a fader towards its target.
+ */
+enum qx_fader_state {
+        /** Faded out: the gain is 0 and stays 0 */
+        QX_FADER_STATE_SILENT = 0,
+        /** Ramping towards 1 */
+        QX_FADER_STATE_FADING_IN,
+        /** Ramping towards 0 */
+        QX_FADER_STATE_FADING_OUT,
+        /** Faded in: the gain is 1 and stays 1 */
+        QX_FADER_STATE_OPEN,
+};
+
 /**
 * @brief Smooth fade in/out for DSP signals.
 *
@@ -46,9 +85,43 @@ extern "C" {
 typedef struct qx_fader {
         float fade;      /**< Current fade value [0..1] */
         float step;      /**< Fade increment per sample */
+        float base_step; /**< Step of the configured fade time, restored by qx_fader_enable() */
+        float sample_rate; /**< Audio sample rate the steps are computed for */
         bool enabled;    /**< Target state: true = fade in, false = fade out */
+        bool retrigger;  /**< qx_fader_enable() continues from the current fade value */
+        bool instant;    /**< The configured fade time is 0 or less */
+        bool time_override; /**< The current fade runs at a time given to qx_fader_enable_time() */
+        bool override_instant; /**< That time is 0 or less */
+        enum qx_fader_curve curve; /**< Gain curve applied to the fade value */
 } qx_fader;
 
+/**
+ * @brief Per-sample step of a full fade.
+ *
+ * @param fadeTime Time to fade in milliseconds, 0 or less for an instant fade.
+ * @param sample_rate Audio sample rate.
+ * @return Fade increment per sample.
+ */
+static inline float qx_fader_time_step(float fadeTime, float sample_rate)
+{
+        if (fadeTime <= 0.0f)
+                return 1.0f; // instant fade
+        return 1000.0f / (fadeTime * sample_rate);
+}
+
+/**
+ * @brief Convert a step to a new sample rate.
+ *
+ * @param step Fade increment per sample.
+ * @param instant True if the step belongs to an instant fade.
+ * @param ratio Old sample rate divided by the new one.
+ * @return Step of the same fade time; an instant fade stays instant.
+ */
+static inline float qx_fader_rescale_step(float step, bool instant, float ratio)
+{
+        return instant ? 1.0f : step * ratio;
+}
+
 /**
  * @brief Initialize a fader.
  *
@@ -63,11 +136,308 @@ static inline void qx_fader_init(struct qx_fader* fader, float fadeTime, float s
 {
         fader->fade = 0.0f;
         fader->enabled = false;
+        fader->retrigger = false;
+        fader->instant = fadeTime <= 0.0f;
+        fader->time_override = false;
+        fader->override_instant = false;
+        fader->curve = QX_FADER_CURVE_LINEAR;
+        fader->step = qx_fader_time_step(fadeTime, sample_rate);
+        fader->base_step = fader->step;
+        fader->sample_rate = sample_rate;
+}
 
-        if (fadeTime <= 0.0f)
-                fader->step = 1.0f; // instant fade
+/**
+ * @brief Change the fade time without touching the fade position.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param fadeTime Time to fade in milliseconds.
+ *
+ * A fade in progress continues at the new speed from where it is, unless
+ * it runs at a time given to qx_fader_enable_time(), which is kept until
+ * the next qx_fader_enable(). Cheap enough to call from automation.
+ */
+static inline void qx_fader_set_time(struct qx_fader* fader, float fadeTime)
+{
+        fader->base_step = qx_fader_time_step(fadeTime, fader->sample_rate);
+        fader->instant = fadeTime <= 0.0f;
+        if (!fader->time_override)
+                fader->step = fader->base_step;
+}
+
+/**
+ * @brief Change the sample rate without touching the fade position.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param sample_rate New audio sample rate.
+ *
+ * The steps are scaled so the fade times stay the same, including the
+ * time of a fade started with qx_fader_enable_time().
+ */
+static inline void qx_fader_set_sample_rate(struct qx_fader* fader, float sample_rate)
+{
+        float ratio = fader->sample_rate / sample_rate;
+        fader->base_step = qx_fader_rescale_step(fader->base_step, fader->instant, ratio);
+        if (fader->time_override)
+                fader->step = qx_fader_rescale_step(fader->step, fader->override_instant, ratio);
         else
-                fader->step = 1.0f / ((fadeTime / 1000.0f) * sample_rate);
+                fader->step = fader->base_step;
+        fader->sample_rate = sample_rate;
+}
+
+/**
+ * @brief Set the gain curve of the fader.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param curve Gain curve; takes effect from the next sample.
+ */
+static inline void qx_fader_set_curve(struct qx_fader* fader, enum qx_fader_curve curve)
+{
+        fader->curve = curve;
+}
+
+/**
+ * @brief Select what qx_fader_enable() does with the current fade value.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param retrigger false (the default) to restart every fade from 0 or 1,
+ *                  true to continue from the current fade value, so a
+ *                  fade-out triggered in the middle of a fade-in starts
+ *                  at the current gain instead of clicking to 1.
+ */
+static inline void qx_fader_set_retrigger(struct qx_fader* fader, bool retrigger)
+{
+        fader->retrigger = retrigger;
+}
+
+/*
+ * Curve evaluation. sin(pi/2 x) is an odd degree 7 polynomial, maximum
+ * error 6.8e-7 on [0, 1] and exact at 0 and 1; the exponential curves use
+ * qx_fast_exp2f(). Both cost a few multiply-adds per sample, also in the
+ * vector versions below.
+ */
+#define QX_FADER_SIN_C1 1.57079033f
+#define QX_FADER_SIN_C3 -0.645886136f
+#define QX_FADER_SIN_C5 0.0794184348f
+#define QX_FADER_SIN_C7 -0.00432263132f
+
+/** log2(1001), the exponent range of the exponential curves */
+#define QX_FADER_EXP_RANGE 9.96722626f
+
+/** 1 / (1001 - 1), rounded up so that the curves reach exactly 1 */
+#define QX_FADER_EXP_SCALE 0.0010000002f
+
+static inline float qx_fader_curve_sin(float x)
+{
+        float x2 = x * x;
+        return x * (QX_FADER_SIN_C1 + x2 * (QX_FADER_SIN_C3 + x2 * (QX_FADER_SIN_C5 + x2 * QX_FADER_SIN_C7)));
+}
+
+static inline float qx_fader_curve_exp(float x)
+{
+        return qx_clamp_float((qx_fast_exp2f(QX_FADER_EXP_RANGE * x) - 1.0f) * QX_FADER_EXP_SCALE, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Gain of a curve at a fade value.
+ *
+ * @param curve Gain curve.
+ * @param x Fade value [0..1].
+ * @return Gain [0..1].
+ */
+static inline float qx_fader_curve_gain(enum qx_fader_curve curve, float x)
+{
+        switch (curve) {
+        case QX_FADER_CURVE_EQUAL_POWER:
+                return qx_fader_curve_sin(x);
+        case QX_FADER_CURVE_EXPONENTIAL:
+                return qx_fader_curve_exp(x);
+        case QX_FADER_CURVE_LOGARITHMIC:
+                return 1.0f - qx_fader_curve_exp(1.0f - x);
+        case QX_FADER_CURVE_RAISED_COSINE:
+        {
+                float s = qx_fader_curve_sin(x);
+                return s * s;
+        }
+        case QX_FADER_CURVE_LINEAR:
+        default:
+                return x;
+        }
+}
+
+#if defined(QX_SIMD_AVX2)
+static inline __m256 qx_fader_curve_sin_avx2(__m256 x)
+{
+        __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(QX_FADER_SIN_C7)), _mm256_set1_ps(QX_FADER_SIN_C5));
+        p = _mm256_add_ps(_mm256_mul_ps(x2, p), _mm256_set1_ps(QX_FADER_SIN_C3));
+        p = _mm256_add_ps(_mm256_mul_ps(x2, p), _mm256_set1_ps(QX_FADER_SIN_C1));
+        return _mm256_mul_ps(x, p);
+}
+
+static inline __m256 qx_fader_curve_exp_avx2(__m256 x)
+{
+        __m256 e = qx_fast_exp2_avx2(_mm256_mul_ps(x, _mm256_set1_ps(QX_FADER_EXP_RANGE)));
+        __m256 g = _mm256_mul_ps(_mm256_sub_ps(e, _mm256_set1_ps(1.0f)), _mm256_set1_ps(QX_FADER_EXP_SCALE));
+        return _mm256_min_ps(_mm256_max_ps(g, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+#elif defined(QX_SIMD_SSE2)
+static inline __m128 qx_fader_curve_sin_sse2(__m128 x)
+{
+        __m128 x2 = _mm_mul_ps(x, x);
+        __m128 p = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(QX_FADER_SIN_C7)), _mm_set1_ps(QX_FADER_SIN_C5));
+        p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(QX_FADER_SIN_C3));
+        p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(QX_FADER_SIN_C1));
+        return _mm_mul_ps(x, p);
+}
+
+static inline __m128 qx_fader_curve_exp_sse2(__m128 x)
+{
+        __m128 e = qx_fast_exp2_sse2(_mm_mul_ps(x, _mm_set1_ps(QX_FADER_EXP_RANGE)));
+        __m128 g = _mm_mul_ps(_mm_sub_ps(e, _mm_set1_ps(1.0f)), _mm_set1_ps(QX_FADER_EXP_SCALE));
+        return _mm_min_ps(_mm_max_ps(g, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+#elif defined(QX_SIMD_NEON)
+static inline float32x4_t qx_fader_curve_sin_neon(float32x4_t x)
+{
+        float32x4_t x2 = vmulq_f32(x, x);
+        float32x4_t p = vaddq_f32(vmulq_n_f32(x2, QX_FADER_SIN_C7), vdupq_n_f32(QX_FADER_SIN_C5));
+        p = vaddq_f32(vmulq_f32(x2, p), vdupq_n_f32(QX_FADER_SIN_C3));
+        p = vaddq_f32(vmulq_f32(x2, p), vdupq_n_f32(QX_FADER_SIN_C1));
+        return vmulq_f32(x, p);
+}
+
+static inline float32x4_t qx_fader_curve_exp_neon(float32x4_t x)
+{
+        float32x4_t e = qx_fast_exp2_neon(vmulq_n_f32(x, QX_FADER_EXP_RANGE));
+        float32x4_t g = vmulq_n_f32(vsubq_f32(e, vdupq_n_f32(1.0f)), QX_FADER_EXP_SCALE);
+        return vminq_f32(vmaxq_f32(g, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+}
+#endif
+
+/**
+ * @brief Map an array of fade values through a gain curve.
+ *
+ * @param curve Gain curve.
+ * @param in Fade values [0..1].
+ * @param out Gains (may be the same as @p in).
+ * @param n Number of values.
+ */
+static inline void qx_fader_curve_array(enum qx_fader_curve curve,
+                                        const float* in,
+                                        float* out,
+                                        size_t n)
+{
+        size_t i = 0;
+        switch (curve) {
+        case QX_FADER_CURVE_EQUAL_POWER:
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= n; i += 8)
+                        _mm256_storeu_ps(out + i, qx_fader_curve_sin_avx2(_mm256_loadu_ps(in + i)));
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= n; i += 4)
+                        _mm_storeu_ps(out + i, qx_fader_curve_sin_sse2(_mm_loadu_ps(in + i)));
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= n; i += 4)
+                        vst1q_f32(out + i, qx_fader_curve_sin_neon(vld1q_f32(in + i)));
+#endif
+                break;
+        case QX_FADER_CURVE_RAISED_COSINE:
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= n; i += 8) {
+                        __m256 g = qx_fader_curve_sin_avx2(_mm256_loadu_ps(in + i));
+                        _mm256_storeu_ps(out + i, _mm256_mul_ps(g, g));
+                }
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= n; i += 4) {
+                        __m128 g = qx_fader_curve_sin_sse2(_mm_loadu_ps(in + i));
+                        _mm_storeu_ps(out + i, _mm_mul_ps(g, g));
+                }
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= n; i += 4) {
+                        float32x4_t g = qx_fader_curve_sin_neon(vld1q_f32(in + i));
+                        vst1q_f32(out + i, vmulq_f32(g, g));
+                }
+#endif
+                break;
+        case QX_FADER_CURVE_EXPONENTIAL:
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= n; i += 8)
+                        _mm256_storeu_ps(out + i, qx_fader_curve_exp_avx2(_mm256_loadu_ps(in + i)));
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= n; i += 4)
+                        _mm_storeu_ps(out + i, qx_fader_curve_exp_sse2(_mm_loadu_ps(in + i)));
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= n; i += 4)
+                        vst1q_f32(out + i, qx_fader_curve_exp_neon(vld1q_f32(in + i)));
+#endif
+                break;
+        case QX_FADER_CURVE_LOGARITHMIC:
+#if defined(QX_SIMD_AVX2)
+                for (; i + 8 <= n; i += 8) {
+                        const __m256 one = _mm256_set1_ps(1.0f);
+                        __m256 x = _mm256_sub_ps(one, _mm256_loadu_ps(in + i));
+                        _mm256_storeu_ps(out + i, _mm256_sub_ps(one, qx_fader_curve_exp_avx2(x)));
+                }
+#elif defined(QX_SIMD_SSE2)
+                for (; i + 4 <= n; i += 4) {
+                        const __m128 one = _mm_set1_ps(1.0f);
+                        __m128 x = _mm_sub_ps(one, _mm_loadu_ps(in + i));
+                        _mm_storeu_ps(out + i, _mm_sub_ps(one, qx_fader_curve_exp_sse2(x)));
+                }
+#elif defined(QX_SIMD_NEON)
+                for (; i + 4 <= n; i += 4) {
+                        const float32x4_t one = vdupq_n_f32(1.0f);
+                        float32x4_t x = vsubq_f32(one, vld1q_f32(in + i));
+                        vst1q_f32(out + i, vsubq_f32(one, qx_fader_curve_exp_neon(x)));
+                }
+#endif
+                break;
+        case QX_FADER_CURVE_LINEAR:
+        default:
+                if (out != in)
+                        memmove(out, in, n * sizeof(float));
+                return;
+        }
+
+        for (; i < n; i++)
+                out[i] = qx_fader_curve_gain(curve, in[i]);
+}
+
+/**
+ * @brief Current gain of the fader.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @return The fade value mapped through the gain curve.
+ */
+static inline float qx_fader_gain(const struct qx_fader* fader)
+{
+        return qx_fader_curve_gain(fader->curve, fader->fade);
+}
+
+/**
+ * @brief Progress of the fader towards its target.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @return QX_FADER_STATE_SILENT or QX_FADER_STATE_OPEN once the fade has
+ *         finished, otherwise the direction of the ramp.
+ */
+static inline enum qx_fader_state qx_fader_get_state(const struct qx_fader* fader)
+{
+        if (fader->enabled)
+                return fader->fade >= 1.0f ? QX_FADER_STATE_OPEN : QX_FADER_STATE_FADING_IN;
+        return fader->fade <= 0.0f ? QX_FADER_STATE_SILENT : QX_FADER_STATE_FADING_OUT;
+}
+
+/**
+ * @brief Check whether the fader has finished fading out.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @return true if every following sample gets a gain of 0, e.g. the
+ *         voice can be freed and does not need to be processed.
+ */
+static inline bool qx_fader_is_silent(const struct qx_fader* fader)
+{
+        return qx_fader_get_state(fader) == QX_FADER_STATE_SILENT;
 }
 
 /**
@@ -77,12 +447,39 @@ static inline void qx_fader_init(struct qx_fader* fader, float fadeTime, float s
  * @param enabled True to fade in, false to fade out.
  *
  * Sets the target state. The fade value will ramp towards
- * 1.0 if enabled or 0.0 if disabled during processing.
+ * 1.0 if enabled or 0.0 if disabled during processing. It restarts
+ * from 0.0 or 1.0 unless retriggering is enabled with
+ * qx_fader_set_retrigger(). The ramp runs at the configured fade time.
  */
 static inline void qx_fader_enable(struct qx_fader* fader, bool enabled)
 {
         fader->enabled = enabled;
-        fader->fade = enabled ? 0.0f : 1.0f;
+        fader->step = fader->base_step;
+        fader->time_override = false;
+        if (!fader->retrigger)
+                fader->fade = enabled ? 0.0f : 1.0f;
+}
+
+/**
+ * @brief Enable or disable the fader with a fade time for this fade only.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param enabled True to fade in, false to fade out.
+ * @param fadeTime Time of a full fade in milliseconds; a fade continuing
+ *                 from the middle takes the corresponding part of it.
+ *
+ * Same as qx_fader_enable(), but the ramp runs at the speed of
+ * @p fadeTime until the next qx_fader_enable() restores the configured
+ * fade time.
+ */
+static inline void qx_fader_enable_time(struct qx_fader* fader,
+                                        bool enabled,
+                                        float fadeTime)
+{
+        qx_fader_enable(fader, enabled);
+        fader->step = qx_fader_time_step(fadeTime, fader->sample_rate);
+        fader->time_override = true;
+        fader->override_instant = fadeTime <= 0.0f;
 }
 
 /**
@@ -94,12 +491,670 @@ static inline void qx_fader_enable(struct qx_fader* fader, bool enabled)
  *
  * Updates the internal fade value and multiplies the input
  * sample by it. Should be called for every audio sample.
+ *
+ * The curve is loop invariant in a per-sample loop, so after inlining
+ * the compiler loads it once and the switch is a predicted branch; the
+ * cost per sample is the fade update chain. An explicit linear fast
+ * path measured slower (see the fader_fade benchmarks) because it moved
+ * the clamp onto that chain. For whole buffers use
+ * qx_fader_process_block(), which evaluates the curve per block.
  */
 static inline float qx_fader_fade(struct qx_fader* fader, float val)
 {
         fader->fade += fader->enabled ? fader->step : -fader->step;
         fader->fade = qx_clamp_float(fader->fade, 0.0f, 1.0f);
-        return val * fader->fade;
+        return val * qx_fader_curve_gain(fader->curve, fader->fade);
+}
+
+/**
+ * @brief Number of frames processed per chunk by the interleaved block API.
+ */
+#define QX_FADER_CHUNK_FRAMES 64
+
+/**
+ * @brief Number of ramping frames in the next block.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param frames Number of frames in the block.
+ * @return Number of leading frames whose gain is still ramping.
+ *         The remaining frames have a constant gain of 0 or 1.
+ *
+ * The clamp point is found analytically once per block instead of
+ * clamping the fade value after every sample.
+ */
+static inline size_t qx_fader_ramp_frames(const struct qx_fader* fader, size_t frames)
+{
+        float remaining = fader->enabled ? 1.0f - fader->fade : fader->fade;
+        if (remaining <= 0.0f)
+                return 0;
+
+        float n = ceilf(remaining / fader->step);
+        if (!(n < (float)frames))
+                return frames;
+        return (size_t)n;
+}
+
+/**
+ * @brief Advance the fade value over a block without producing output.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param frames Number of frames in the block.
+ */
+static inline void qx_fader_advance(struct qx_fader* fader, size_t frames)
+{
+        if (frames == 0)
+                return;
+
+        float delta = fader->enabled ? fader->step : -fader->step;
+        float fade = fader->fade + delta * (float)frames;
+        fader->fade = qx_clamp_float(fade, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Fill a part of the ramp of the next block with gains.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param gain Output gains.
+ * @param pos Offset of the first frame from the start of the block.
+ * @param n Number of frames, at most QX_FADER_CHUNK_FRAMES.
+ */
+static inline void qx_fader_gain_fill(const struct qx_fader* fader, float* gain, size_t pos, size_t n)
+{
+        float delta = fader->enabled ? fader->step : -fader->step;
+        qx_simd_ramp_fill(gain, n, fader->fade + delta * (float)pos, delta, 0.0f, 1.0f);
+        qx_fader_curve_array(fader->curve, gain, gain, n);
+}
+
+/**
+ * @brief Apply the gain curve of the next block without updating the fader.
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param in Input samples.
+ * @param out Output samples (may be the same as @p in).
+ * @param frames Number of samples.
+ */
+static inline void qx_fader_apply_block_out(const struct qx_fader* fader,
+                                            const float* in,
+                                            float* out,
+                                            size_t frames)
+{
+        size_t ramp = qx_fader_ramp_frames(fader, frames);
+        if (ramp > 0) {
+                float delta = fader->enabled ? fader->step : -fader->step;
+                if (fader->curve == QX_FADER_CURVE_LINEAR) {
+                        qx_simd_ramp_mul(in, out, ramp, fader->fade, delta, 0.0f, 1.0f);
+                } else {
+                        float gain[QX_FADER_CHUNK_FRAMES];
+                        for (size_t pos = 0; pos < ramp; pos += QX_FADER_CHUNK_FRAMES) {
+                                size_t n = ramp - pos;
+                                if (n > QX_FADER_CHUNK_FRAMES)
+                                        n = QX_FADER_CHUNK_FRAMES;
+                                qx_fader_gain_fill(fader, gain, pos, n);
+                                qx_simd_mul(in + pos, gain, out + pos, n);
+                        }
+                }
+        }
+
+        if (ramp < frames)
+                qx_simd_scale(in + ramp, out + ramp, frames - ramp,
+                              fader->enabled ? 1.0f : 0.0f);
+}
+
+/**
+ * @brief Apply fade to a block of mono samples (out-of-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param in Input samples.
+ * @param out Output samples (may be the same as @p in).
+ * @param frames Number of samples.
+ *
+ * Matches calling qx_fader_fade() for every sample to float rounding:
+ * the ramping part is computed analytically with SIMD (start + step * i)
+ * instead of by repeated additions, and the fully faded part is a plain
+ * memcpy or memset.
+ */
+static inline void qx_fader_process_block_out(struct qx_fader* fader,
+                                              const float* in,
+                                              float* out,
+                                              size_t frames)
+{
+        qx_fader_apply_block_out(fader, in, out, frames);
+        qx_fader_advance(fader, frames);
+}
+
+/**
+ * @brief Apply fade to a block of mono samples (in-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param buf Samples to process.
+ * @param frames Number of samples.
+ */
+static inline void qx_fader_process_block(struct qx_fader* fader,
+                                          float* buf,
+                                          size_t frames)
+{
+        qx_fader_process_block_out(fader, buf, buf, frames);
+}
+
+/**
+ * @brief Apply fade to a block of mono samples and report where it ends (out-of-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param in Input samples.
+ * @param out Output samples (may be the same as @p in).
+ * @param frames Number of samples.
+ * @return Number of leading frames that were still ramping: frame
+ *         index - 1 is the one where the fader reached its target and
+ *         every frame from index on has exactly the target gain (0 or 1).
+ *         0 if the fade had already finished, @p frames if it finishes
+ *         on the last frame or later.
+ *
+ * Same output as qx_fader_process_block_out(). When the fade finishes
+ * inside the block, including on its last frame, the fade value is set
+ * exactly to the target, so qx_fader_get_state() reports it right after
+ * the call. After a fade-out, out[index..frames) is silent and the voice
+ * can be freed in the same callback.
+ *
+ * @note A return value of @p frames does not tell a fade that ended on
+ *       the last frame from one that is still ramping; check
+ *       qx_fader_get_state() (or qx_fader_is_silent()) to free a voice
+ *       in that case.
+ */
+static inline size_t qx_fader_process_block_end_out(struct qx_fader* fader,
+                                                    const float* in,
+                                                    float* out,
+                                                    size_t frames)
+{
+        float remaining = fader->enabled ? 1.0f - fader->fade : fader->fade;
+        bool done = remaining <= 0.0f || !(ceilf(remaining / fader->step) > (float)frames);
+        size_t end = qx_fader_ramp_frames(fader, frames);
+
+        qx_fader_apply_block_out(fader, in, out, frames);
+        if (done)
+                fader->fade = fader->enabled ? 1.0f : 0.0f;
+        else
+                qx_fader_advance(fader, frames);
+        return end;
+}
+
+/**
+ * @brief Apply fade to a block of mono samples and report where it ends (in-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param buf Samples to process.
+ * @param frames Number of samples.
+ * @return See qx_fader_process_block_end_out().
+ */
+static inline size_t qx_fader_process_block_end(struct qx_fader* fader,
+                                                float* buf,
+                                                size_t frames)
+{
+        return qx_fader_process_block_end_out(fader, buf, buf, frames);
+}
+
+/**
+ * @brief Apply fade to a block of interleaved samples (out-of-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param in Interleaved input samples.
+ * @param out Interleaved output samples (may be the same as @p in).
+ * @param frames Number of frames.
+ * @param channels Number of channels per frame.
+ *
+ * All channels of a frame get the same gain.
+ */
+static inline void qx_fader_process_interleaved_out(struct qx_fader* fader,
+                                                    const float* in,
+                                                    float* out,
+                                                    size_t frames,
+                                                    size_t channels)
+{
+        if (channels == 1) {
+                qx_fader_process_block_out(fader, in, out, frames);
+                return;
+        }
+
+        size_t ramp = qx_fader_ramp_frames(fader, frames);
+        float gain[QX_FADER_CHUNK_FRAMES];
+
+        for (size_t pos = 0; pos < ramp; pos += QX_FADER_CHUNK_FRAMES) {
+                size_t n = ramp - pos;
+                if (n > QX_FADER_CHUNK_FRAMES)
+                        n = QX_FADER_CHUNK_FRAMES;
+
+                qx_fader_gain_fill(fader, gain, pos, n);
+
+                const float* src = in + pos * channels;
+                float* dst = out + pos * channels;
+                for (size_t i = 0; i < n; i++)
+                        for (size_t c = 0; c < channels; c++)
+                                dst[i * channels + c] = src[i * channels + c] * gain[i];
+        }
+
+        if (ramp < frames)
+                qx_simd_scale(in + ramp * channels,
+                              out + ramp * channels,
+                              (frames - ramp) * channels,
+                              fader->enabled ? 1.0f : 0.0f);
+
+        qx_fader_advance(fader, frames);
+}
+
+/**
+ * @brief Apply fade to a block of interleaved samples (in-place).
+ *
+ * @param fader Pointer to qx_fader struct.
+ * @param buf Interleaved samples to process.
+ * @param frames Number of frames.
+ * @param channels Number of channels per frame.
+ */
+static inline void qx_fader_process_interleaved(struct qx_fader* fader,
+                                                float* buf,
+                                                size_t frames,
+                                                size_t channels)
+{
+        qx_fader_process_interleaved_out(fader, buf, buf, frames, channels);
+}
+
+/**
+ * @brief Structure-of-arrays storage for many faders.
+ *
+ * Keeps the fade values and steps of all faders in contiguous aligned
+ * arrays and the enabled flags in a bitmask, so the state of many voices
+ * can be updated in one vectorized pass. The scalar API works on a copy of
+ * one voice: qx_fader_bank_load() copies it into a struct qx_fader and
+ * qx_fader_bank_store() copies it back. Changes to the copy do not reach
+ * the bank until it is stored, and a stored copy overwrites whatever the
+ * bank functions did to that voice in between.
+ *
+ * The arrays are padded to a multiple of QX_FADER_BANK_PAD faders. Padding
+ * faders have a zero step and never change.
+ */
+typedef struct qx_fader_bank {
+        float* fade;        /**< Current fade values [0..1], one per fader */
+        float* step;        /**< Fade increments per sample, one per fader */
+        float* base_step;   /**< Steps of the configured fade times, one per fader */
+        uint32_t* enabled;  /**< Enabled bitmask, bit (i % 32) of word (i / 32) */
+        uint8_t* flags;     /**< QX_FADER_BANK_* fade time flags, one per fader */
+        size_t count;       /**< Number of faders */
+        size_t capacity;    /**< Number of faders including padding */
+        enum qx_fader_curve curve; /**< Gain curve shared by all faders */
+        bool retrigger;     /**< Retrigger mode shared by all faders */
+        float sample_rate;  /**< Audio sample rate shared by all faders */
+} qx_fader_bank;
+
+/**
+ * @brief Padding granularity of the fader bank arrays.
+ */
+#define QX_FADER_BANK_PAD 32
+
+/**
+ * @brief Fade time flags of a bank fader, see struct qx_fader.
+ */
+#define QX_FADER_BANK_INSTANT          (1u << 0) /**< qx_fader::instant */
+#define QX_FADER_BANK_TIME_OVERRIDE    (1u << 1) /**< qx_fader::time_override */
+#define QX_FADER_BANK_OVERRIDE_INSTANT (1u << 2) /**< qx_fader::override_instant */
+
+/**
+ * @brief Initialize a fader bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param count Number of faders.
+ * @param fadeTime Time to fade in milliseconds.
+ * @param sample_rate Audio sample rate.
+ * @return true on success, false if memory allocation failed.
+ *
+ * Every fader is initialized as with qx_fader_init().
+ * The bank must be released with qx_fader_bank_free().
+ */
+static inline bool qx_fader_bank_init(struct qx_fader_bank* bank,
+                                      size_t count,
+                                      float fadeTime,
+                                      float sample_rate)
+{
+        struct qx_fader proto;
+        qx_fader_init(&proto, fadeTime, sample_rate);
+
+        bank->count = count;
+        bank->curve = proto.curve;
+        bank->retrigger = proto.retrigger;
+        bank->sample_rate = proto.sample_rate;
+        bank->capacity = (count + QX_FADER_BANK_PAD - 1) / QX_FADER_BANK_PAD * QX_FADER_BANK_PAD;
+        if (bank->capacity == 0)
+                bank->capacity = QX_FADER_BANK_PAD;
+
+        bank->fade = (float*)qx_simd_aligned_alloc(bank->capacity * sizeof(float));
+        bank->step = (float*)qx_simd_aligned_alloc(bank->capacity * sizeof(float));
+        bank->base_step = (float*)qx_simd_aligned_alloc(bank->capacity * sizeof(float));
+        bank->enabled = (uint32_t*)qx_simd_aligned_alloc(bank->capacity / 32 * sizeof(uint32_t));
+        bank->flags = (uint8_t*)qx_simd_aligned_alloc(bank->capacity * sizeof(uint8_t));
+        if (!bank->fade || !bank->step || !bank->base_step || !bank->enabled || !bank->flags) {
+                qx_simd_aligned_free(bank->fade);
+                qx_simd_aligned_free(bank->step);
+                qx_simd_aligned_free(bank->base_step);
+                qx_simd_aligned_free(bank->enabled);
+                qx_simd_aligned_free(bank->flags);
+                bank->fade = NULL;
+                bank->step = NULL;
+                bank->base_step = NULL;
+                bank->enabled = NULL;
+                bank->flags = NULL;
+                bank->count = bank->capacity = 0;
+                return false;
+        }
+
+        for (size_t i = 0; i < bank->capacity; i++) {
+                bank->fade[i] = proto.fade;
+                bank->step[i] = i < count ? proto.step : 0.0f;
+                bank->base_step[i] = bank->step[i];
+                bank->flags[i] = i < count && proto.instant ? QX_FADER_BANK_INSTANT : 0u;
+        }
+        memset(bank->enabled, 0, bank->capacity / 32 * sizeof(uint32_t));
+        return true;
+}
+
+/**
+ * @brief Release the memory of a fader bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ */
+static inline void qx_fader_bank_free(struct qx_fader_bank* bank)
+{
+        qx_simd_aligned_free(bank->fade);
+        qx_simd_aligned_free(bank->step);
+        qx_simd_aligned_free(bank->base_step);
+        qx_simd_aligned_free(bank->enabled);
+        qx_simd_aligned_free(bank->flags);
+        bank->fade = NULL;
+        bank->step = NULL;
+        bank->base_step = NULL;
+        bank->enabled = NULL;
+        bank->flags = NULL;
+        bank->count = bank->capacity = 0;
+}
+
+/**
+ * @brief Set the gain curve of all faders of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param curve Gain curve.
+ */
+static inline void qx_fader_bank_set_curve(struct qx_fader_bank* bank, enum qx_fader_curve curve)
+{
+        bank->curve = curve;
+}
+
+/**
+ * @brief Set the retrigger mode of all faders of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param retrigger See qx_fader_set_retrigger().
+ */
+static inline void qx_fader_bank_set_retrigger(struct qx_fader_bank* bank, bool retrigger)
+{
+        bank->retrigger = retrigger;
+}
+
+/**
+ * @brief Change the fade time of all faders of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param fadeTime Time to fade in milliseconds.
+ *
+ * Same semantics as qx_fader_set_time() for every fader, in one pass
+ * over the step arrays.
+ */
+static inline void qx_fader_bank_set_time(struct qx_fader_bank* bank, float fadeTime)
+{
+        const float base = qx_fader_time_step(fadeTime, bank->sample_rate);
+        const uint8_t instant = fadeTime <= 0.0f ? QX_FADER_BANK_INSTANT : 0u;
+        for (size_t i = 0; i < bank->count; i++) {
+                uint8_t flags = bank->flags[i];
+                if (!(flags & QX_FADER_BANK_TIME_OVERRIDE))
+                        bank->step[i] = base;
+                bank->base_step[i] = base;
+                bank->flags[i] = (uint8_t)((flags & ~QX_FADER_BANK_INSTANT) | instant);
+        }
+}
+
+/**
+ * @brief Change the sample rate of all faders of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param sample_rate New audio sample rate.
+ *
+ * Same semantics as qx_fader_set_sample_rate() for every fader, in one
+ * pass over the step arrays. The padding faders keep their zero step.
+ */
+static inline void qx_fader_bank_set_sample_rate(struct qx_fader_bank* bank, float sample_rate)
+{
+        const float ratio = bank->sample_rate / sample_rate;
+        for (size_t i = 0; i < bank->capacity; i++) {
+                uint8_t flags = bank->flags[i];
+                float base = qx_fader_rescale_step(bank->base_step[i],
+                                                   flags & QX_FADER_BANK_INSTANT, ratio);
+                float step = qx_fader_rescale_step(bank->step[i],
+                                                   flags & QX_FADER_BANK_OVERRIDE_INSTANT, ratio);
+                bank->step[i] = flags & QX_FADER_BANK_TIME_OVERRIDE ? step : base;
+                bank->base_step[i] = base;
+        }
+        bank->sample_rate = sample_rate;
+}
+
+/**
+ * @brief Copy the state of one fader of the bank into a qx_fader.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param index Fader index.
+ * @param fader Destination fader.
+ *
+ * The copy is independent of the bank, store it back with
+ * qx_fader_bank_store() after changing it.
+ */
+static inline void qx_fader_bank_load(const struct qx_fader_bank* bank,
+                                      size_t index,
+                                      struct qx_fader* fader)
+{
+        fader->fade = bank->fade[index];
+        fader->step = bank->step[index];
+        fader->base_step = bank->base_step[index];
+        fader->enabled = (bank->enabled[index / 32] >> (index % 32)) & 1u;
+        fader->instant = bank->flags[index] & QX_FADER_BANK_INSTANT;
+        fader->time_override = bank->flags[index] & QX_FADER_BANK_TIME_OVERRIDE;
+        fader->override_instant = bank->flags[index] & QX_FADER_BANK_OVERRIDE_INSTANT;
+        fader->retrigger = bank->retrigger;
+        fader->sample_rate = bank->sample_rate;
+        fader->curve = bank->curve;
+}
+
+/**
+ * @brief Copy the state of a qx_fader into one fader of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param index Fader index.
+ * @param fader Source fader.
+ *
+ * The curve, the retrigger mode and the sample rate are shared by the
+ * whole bank, see qx_fader_bank_set_curve(), qx_fader_bank_set_retrigger()
+ * and qx_fader_bank_set_sample_rate().
+ */
+static inline void qx_fader_bank_store(struct qx_fader_bank* bank,
+                                       size_t index,
+                                       const struct qx_fader* fader)
+{
+        uint32_t bit = 1u << (index % 32);
+        bank->fade[index] = fader->fade;
+        bank->step[index] = fader->step;
+        bank->base_step[index] = fader->base_step;
+        bank->flags[index] = (uint8_t)((fader->instant ? QX_FADER_BANK_INSTANT : 0u)
+                                       | (fader->time_override ? QX_FADER_BANK_TIME_OVERRIDE : 0u)
+                                       | (fader->override_instant ? QX_FADER_BANK_OVERRIDE_INSTANT : 0u));
+        if (fader->enabled)
+                bank->enabled[index / 32] |= bit;
+        else
+                bank->enabled[index / 32] &= ~bit;
+}
+
+/**
+ * @brief Enable or disable one fader of the bank.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param index Fader index.
+ * @param enabled True to fade in, false to fade out.
+ *
+ * Same semantics as qx_fader_enable().
+ */
+static inline void qx_fader_bank_enable(struct qx_fader_bank* bank,
+                                        size_t index,
+                                        bool enabled)
+{
+        struct qx_fader fader;
+        qx_fader_bank_load(bank, index, &fader);
+        qx_fader_enable(&fader, enabled);
+        qx_fader_bank_store(bank, index, &fader);
+}
+
+/**
+ * @brief Enable or disable one fader of the bank with a fade time for this fade only.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param index Fader index.
+ * @param enabled True to fade in, false to fade out.
+ * @param fadeTime Time of a full fade in milliseconds.
+ *
+ * Same semantics as qx_fader_enable_time().
+ */
+static inline void qx_fader_bank_enable_time(struct qx_fader_bank* bank,
+                                             size_t index,
+                                             bool enabled,
+                                             float fadeTime)
+{
+        struct qx_fader fader;
+        qx_fader_bank_load(bank, index, &fader);
+        qx_fader_enable_time(&fader, enabled, fadeTime);
+        qx_fader_bank_store(bank, index, &fader);
+}
+
+/**
+ * @brief Progress of one fader of the bank towards its target.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param index Fader index.
+ * @return See qx_fader_get_state().
+ */
+static inline enum qx_fader_state qx_fader_bank_get_state(const struct qx_fader_bank* bank,
+                                                          size_t index)
+{
+        struct qx_fader fader;
+        qx_fader_bank_load(bank, index, &fader);
+        return qx_fader_get_state(&fader);
+}
+
+/**
+ * @brief Advance all faders of the bank over a block.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param frames Number of frames in the block.
+ *
+ * Equivalent to calling qx_fader_advance() on every fader,
+ * done in one vectorized pass over the bank.
+ */
+static inline void qx_fader_bank_advance(struct qx_fader_bank* bank, size_t frames)
+{
+        if (frames == 0)
+                return;
+
+        const float n = (float)frames;
+        size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+        {
+                const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+                const __m256 vn = _mm256_set1_ps(n);
+                const __m256 zero = _mm256_setzero_ps();
+                const __m256 one = _mm256_set1_ps(1.0f);
+                for (; i < bank->capacity; i += 8) {
+                        uint32_t m = (bank->enabled[i / 32] >> (i % 32)) & 0xffu;
+                        __m256i on = _mm256_and_si256(_mm256_set1_epi32((int)m), bits);
+                        on = _mm256_cmpeq_epi32(on, bits);
+                        __m256 step = _mm256_load_ps(bank->step + i);
+                        __m256 delta = _mm256_blendv_ps(_mm256_sub_ps(zero, step), step,
+                                                        _mm256_castsi256_ps(on));
+                        __m256 fade = _mm256_add_ps(_mm256_load_ps(bank->fade + i),
+                                                    _mm256_mul_ps(delta, vn));
+                        fade = _mm256_min_ps(_mm256_max_ps(fade, zero), one);
+                        _mm256_store_ps(bank->fade + i, fade);
+                }
+        }
+#elif defined(QX_SIMD_SSE2)
+        {
+                const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+                const __m128 vn = _mm_set1_ps(n);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.0f);
+                for (; i < bank->capacity; i += 4) {
+                        uint32_t m = (bank->enabled[i / 32] >> (i % 32)) & 0xfu;
+                        __m128i on = _mm_and_si128(_mm_set1_epi32((int)m), bits);
+                        __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(on, bits));
+                        __m128 step = _mm_load_ps(bank->step + i);
+                        __m128 delta = _mm_or_ps(_mm_and_ps(mask, step),
+                                                 _mm_andnot_ps(mask, _mm_sub_ps(zero, step)));
+                        __m128 fade = _mm_add_ps(_mm_load_ps(bank->fade + i),
+                                                 _mm_mul_ps(delta, vn));
+                        fade = _mm_min_ps(_mm_max_ps(fade, zero), one);
+                        _mm_store_ps(bank->fade + i, fade);
+                }
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                const uint32_t bits_init[4] = {1u, 2u, 4u, 8u};
+                const uint32x4_t bits = vld1q_u32(bits_init);
+                const float32x4_t zero = vdupq_n_f32(0.0f);
+                const float32x4_t one = vdupq_n_f32(1.0f);
+                for (; i < bank->capacity; i += 4) {
+                        uint32_t m = (bank->enabled[i / 32] >> (i % 32)) & 0xfu;
+                        uint32x4_t on = vtstq_u32(vdupq_n_u32(m), bits);
+                        float32x4_t step = vld1q_f32(bank->step + i);
+                        float32x4_t delta = vbslq_f32(on, step, vnegq_f32(step));
+                        float32x4_t fade = vaddq_f32(vld1q_f32(bank->fade + i),
+                                                     vmulq_n_f32(delta, n));
+                        fade = vminq_f32(vmaxq_f32(fade, zero), one);
+                        vst1q_f32(bank->fade + i, fade);
+                }
+        }
+#endif
+        for (; i < bank->capacity; i++) {
+                bool enabled = (bank->enabled[i / 32] >> (i % 32)) & 1u;
+                float delta = enabled ? bank->step[i] : -bank->step[i];
+                float fade = bank->fade[i] + delta * n;
+                bank->fade[i] = qx_clamp_float(fade, 0.0f, 1.0f);
+        }
+}
+
+/**
+ * @brief Apply every fader of the bank to its own mono buffer in-place.
+ *
+ * @param bank Pointer to qx_fader_bank struct.
+ * @param bufs Array of bank->count buffer pointers. A NULL entry
+ *             only advances the corresponding fader.
+ * @param frames Number of samples in every buffer.
+ *
+ * The gain curves are applied per voice with the SIMD block kernels
+ * and the fader states are then advanced in one vectorized pass.
+ */
+static inline void qx_fader_bank_process(struct qx_fader_bank* bank,
+                                         float* const* bufs,
+                                         size_t frames)
+{
+        for (size_t v = 0; v < bank->count; v++) {
+                if (!bufs[v])
+                        continue;
+
+                struct qx_fader fader;
+                qx_fader_bank_load(bank, v, &fader);
+                qx_fader_apply_block_out(&fader, bufs[v], bufs[v], frames);
+        }
+
+        qx_fader_bank_advance(bank, frames);
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,456 @@
+/**
+ * @file qx_interp.h
+ * @brief Higher order fractional reads from circular (ring) buffers.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_INTERP_H
+#define QX_INTERP_H
+
+#include "qx_math.h"
+#include "qx_simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * All readers use the same index convention as qx_ring_interp_linear():
+ * the read index is in [0, size) (one extra wrap, up to 2 * size, is
+ * tolerated) and neighbouring samples wrap around the ends of the buffer.
+ * The 4-point kernels read the samples at i - 1, i, i + 1 and i + 2.
+ */
+
+/**
+ * @brief Wrap a sample index that is at most one buffer length out of range.
+ *
+ * @param i Sample index in [-size, 2 * size).
+ * @param size Size of the buffer.
+ * @return Index in [0, size).
+ */
+static inline int qx_ring_wrap_index(int i, int size)
+{
+        if (i < 0)
+                i += size;
+        else if (i >= size)
+                i -= size;
+        return i;
+}
+
+/**
+ * @brief Read the four samples around a fractional index.
+ *
+ * @param buf Pointer to the buffer.
+ * @param index Floating-point read index.
+ * @param size Size of the buffer.
+ * @param y Returned samples at i - 1, i, i + 1 and i + 2.
+ * @return Fractional part of the index.
+ */
+static inline float qx_ring_read4(const float* buf, float index, int size, float y[4])
+{
+        int i = (int)index;
+        float k = index - (float)i;
+        i = qx_ring_wrap_index(i, size);
+
+        y[0] = buf[qx_ring_wrap_index(i - 1, size)];
+        y[1] = buf[i];
+        y[2] = buf[qx_ring_wrap_index(i + 1, size)];
+        y[3] = buf[qx_ring_wrap_index(i + 2, size)];
+        return k;
+}
+
+/**
+ * @brief Catmull-Rom polynomial through four equally spaced samples.
+ *
+ * @param ym1 Sample at position -1.
+ * @param y0 Sample at position 0.
+ * @param y1 Sample at position 1.
+ * @param y2 Sample at position 2.
+ * @param k Fractional position in [0, 1).
+ * @return Interpolated value between y0 and y1.
+ */
+static inline float qx_interp_hermite4(float ym1, float y0, float y1, float y2, float k)
+{
+        float c1 = 0.5f * (y1 - ym1);
+        float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+        float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+        return ((c3 * k + c2) * k + c1) * k + y0;
+}
+
+/**
+ * @brief Catmull-Rom (cubic Hermite) interpolation from a ring buffer.
+ *
+ * Passes through the samples with a continuous first derivative.
+ * Much less high-frequency roll-off than linear interpolation.
+ *
+ * @param buf Pointer to the buffer.
+ * @param index Floating-point read index.
+ * @param size Size of the buffer.
+ * @return Interpolated sample value.
+ */
+static inline float qx_ring_interp_hermite(const float* buf, float index, int size)
+{
+        float y[4];
+        float k = qx_ring_read4(buf, index, size, y);
+        return qx_interp_hermite4(y[0], y[1], y[2], y[3], k);
+}
+
+/**
+ * @brief 4-point, 3rd order Lagrange interpolation from a ring buffer.
+ *
+ * Flatter passband than Catmull-Rom at the cost of a slightly
+ * less smooth impulse response.
+ *
+ * @param buf Pointer to the buffer.
+ * @param index Floating-point read index.
+ * @param size Size of the buffer.
+ * @return Interpolated sample value.
+ */
+static inline float qx_ring_interp_lagrange4(const float* buf, float index, int size)
+{
+        float y[4];
+        float k = qx_ring_read4(buf, index, size, y);
+
+        float c1 = y[2] - (1.0f / 3.0f) * y[0] - 0.5f * y[1] - (1.0f / 6.0f) * y[3];
+        float c2 = 0.5f * (y[0] + y[2]) - y[1];
+        float c3 = (1.0f / 6.0f) * (y[3] - y[0]) + 0.5f * (y[1] - y[2]);
+        return ((c3 * k + c2) * k + c1) * k + y[1];
+}
+
+/** Maximum number of taps of a windowed-sinc table. */
+#define QX_SINC_MAX_TAPS 64
+
+/**
+ * @brief Polyphase windowed-sinc interpolation table.
+ *
+ * Holds `phases + 1` rows of `taps` Blackman-windowed sinc coefficients.
+ * Fractional positions between two rows are linearly interpolated.
+ */
+struct qx_sinc_table {
+        float* coeffs;   /**< (phases + 1) * taps coefficients, row-major */
+        int taps;        /**< Number of taps, a multiple of 4 */
+        int phases;      /**< Number of phases per sample */
+};
+
+/**
+ * @brief Build a windowed-sinc interpolation table.
+ *
+ * @param table Pointer to qx_sinc_table struct.
+ * @param taps Number of taps, rounded up to a multiple of 4 in [4, QX_SINC_MAX_TAPS].
+ * @param phases Number of phases per sample, e.g. 256.
+ * @return true on success, false if memory allocation failed.
+ *
+ * The table must be released with qx_sinc_table_free().
+ */
+static inline bool qx_sinc_table_init(struct qx_sinc_table* table, int taps, int phases)
+{
+        taps = taps < 4 ? 4 : taps > QX_SINC_MAX_TAPS ? QX_SINC_MAX_TAPS : (taps + 3) / 4 * 4;
+        phases = phases < 1 ? 1 : phases;
+
+        table->coeffs = (float*)qx_simd_aligned_alloc((size_t)(phases + 1) * (size_t)taps * sizeof(float));
+        if (!table->coeffs) {
+                table->taps = table->phases = 0;
+                return false;
+        }
+
+        table->taps = taps;
+        table->phases = phases;
+
+        double half = taps / 2;
+        for (int p = 0; p <= phases; p++) {
+                double row[QX_SINC_MAX_TAPS];
+                double sum = 0.0;
+                for (int j = 0; j < taps; j++) {
+                        double t = (double)p / phases + (half - 1.0) - j;
+                        double x = t / half;
+                        double h = 0.0;
+                        if (fabs(x) < 1.0) {
+                                double sinc = t == 0.0 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+                                double w = 0.42 + 0.5 * cos(M_PI * x) + 0.08 * cos(2.0 * M_PI * x);
+                                h = sinc * w;
+                        }
+                        row[j] = h;
+                        sum += h;
+                }
+
+                // Unity gain at DC for every phase
+                for (int j = 0; j < taps; j++)
+                        table->coeffs[p * taps + j] = (float)(row[j] / sum);
+        }
+
+        return true;
+}
+
+/**
+ * @brief Release the memory of a windowed-sinc table.
+ *
+ * @param table Pointer to qx_sinc_table struct.
+ */
+static inline void qx_sinc_table_free(struct qx_sinc_table* table)
+{
+        qx_simd_aligned_free(table->coeffs);
+        table->coeffs = NULL;
+        table->taps = table->phases = 0;
+}
+
+/**
+ * @brief Windowed-sinc interpolation from a ring buffer.
+ *
+ * @param table Pointer to an initialized qx_sinc_table.
+ * @param buf Pointer to the buffer.
+ * @param index Floating-point read index.
+ * @param size Size of the buffer, at least table->taps.
+ * @return Interpolated sample value.
+ *
+ * Reads table->taps samples centered on the index. The dot product
+ * runs with SIMD; the samples are copied first to resolve wraparound.
+ */
+static inline float qx_ring_interp_sinc(const struct qx_sinc_table* table,
+                                        const float* buf,
+                                        float index,
+                                        int size)
+{
+        int i = (int)index;
+        float k = index - (float)i;
+        const int taps = table->taps;
+
+        float pos = k * (float)table->phases;
+        int p = (int)pos;
+        float pk = pos - (float)p;
+        const float* c0 = table->coeffs + p * taps;
+        const float* c1 = c0 + taps;
+
+        // First tap reads sample i - taps / 2 + 1
+        int first = qx_ring_wrap_index(qx_ring_wrap_index(i, size) - taps / 2 + 1, size);
+        float samples[QX_SINC_MAX_TAPS];
+        const float* y = buf + first;
+        if (first + taps > size) {
+                for (int j = 0; j < taps; j++)
+                        samples[j] = buf[qx_ring_wrap_index(first + j, size)];
+                y = samples;
+        }
+
+        int j = 0;
+        float sum = 0.0f;
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 vk = _mm_set1_ps(pk);
+                __m128 acc = _mm_setzero_ps();
+                for (; j < taps; j += 4) {
+                        __m128 a = _mm_load_ps(c0 + j);
+                        __m128 c = _mm_add_ps(a, _mm_mul_ps(vk, _mm_sub_ps(_mm_load_ps(c1 + j), a)));
+                        acc = _mm_add_ps(acc, _mm_mul_ps(c, _mm_loadu_ps(y + j)));
+                }
+                acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+                acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+                sum = _mm_cvtss_f32(acc);
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                float32x4_t acc = vdupq_n_f32(0.0f);
+                for (; j < taps; j += 4) {
+                        float32x4_t a = vld1q_f32(c0 + j);
+                        float32x4_t c = vaddq_f32(a, vmulq_n_f32(vsubq_f32(vld1q_f32(c1 + j), a), pk));
+                        acc = vaddq_f32(acc, vmulq_f32(c, vld1q_f32(y + j)));
+                }
+                float32x2_t s = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+                sum = vget_lane_f32(vpadd_f32(s, s), 0);
+        }
+#endif
+        for (; j < taps; j++)
+                sum += (c0[j] + pk * (c1[j] - c0[j])) * y[j];
+        return sum;
+}
+
+#if defined(QX_SIMD_AVX2)
+/**
+ * @brief Catmull-Rom polynomial for eight positions (AVX2).
+ */
+static inline __m256 qx_interp_hermite4_avx2(__m256 ym1, __m256 y0, __m256 y1, __m256 y2, __m256 k)
+{
+        const __m256 half = _mm256_set1_ps(0.5f);
+        __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(y1, ym1));
+        __m256 c2 = _mm256_sub_ps(_mm256_add_ps(ym1, _mm256_mul_ps(_mm256_set1_ps(2.0f), y1)),
+                                  _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.5f), y0),
+                                                _mm256_mul_ps(half, y2)));
+        __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(y2, ym1)),
+                                  _mm256_mul_ps(_mm256_set1_ps(1.5f), _mm256_sub_ps(y0, y1)));
+        __m256 r = _mm256_add_ps(_mm256_mul_ps(c3, k), c2);
+        r = _mm256_add_ps(_mm256_mul_ps(r, k), c1);
+        return _mm256_add_ps(_mm256_mul_ps(r, k), y0);
+}
+
+/**
+ * @brief Gather the four samples around eight fractional indices (AVX2).
+ *
+ * @return Fractional parts of the indices.
+ */
+static inline __m256 qx_ring_gather4_avx2(const float* buf, __m256 index, int size,
+                                          __m256* ym1, __m256* y0, __m256* y1, __m256* y2)
+{
+        const __m256i vsize = _mm256_set1_epi32(size);
+        const __m256i one = _mm256_set1_epi32(1);
+        __m256i i = _mm256_cvttps_epi32(index);
+        __m256 k = _mm256_sub_ps(index, _mm256_cvtepi32_ps(i));
+
+        // Wrap i into [0, size), then the neighbours by at most one length
+        i = _mm256_sub_epi32(i, _mm256_andnot_si256(_mm256_cmpgt_epi32(vsize, i), vsize));
+        __m256i im1 = _mm256_sub_epi32(i, one);
+        im1 = _mm256_add_epi32(im1, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), im1), vsize));
+        __m256i i1 = _mm256_add_epi32(i, one);
+        i1 = _mm256_sub_epi32(i1, _mm256_andnot_si256(_mm256_cmpgt_epi32(vsize, i1), vsize));
+        __m256i i2 = _mm256_add_epi32(i1, one);
+        i2 = _mm256_sub_epi32(i2, _mm256_andnot_si256(_mm256_cmpgt_epi32(vsize, i2), vsize));
+
+        *ym1 = _mm256_i32gather_ps(buf, im1, 4);
+        *y0 = _mm256_i32gather_ps(buf, i, 4);
+        *y1 = _mm256_i32gather_ps(buf, i1, 4);
+        *y2 = _mm256_i32gather_ps(buf, i2, 4);
+        return k;
+}
+#endif
+
+/**
+ * @brief Linear interpolation of a block of fractional indices.
+ *
+ * @param buf Pointer to the buffer.
+ * @param size Size of the buffer.
+ * @param index Read indices, one per output sample.
+ * @param out Output samples.
+ * @param n Number of samples.
+ *
+ * Uses AVX2 gathers when available.
+ */
+static inline void qx_ring_read_linear_block(const float* buf, int size,
+                                             const float* index, float* out, size_t n)
+{
+        size_t j = 0;
+#if defined(QX_SIMD_AVX2)
+        const __m256i vsize = _mm256_set1_epi32(size);
+        for (; j < (n & ~(size_t)7); j += 8) {
+                __m256 x = _mm256_loadu_ps(index + j);
+                __m256i i = _mm256_cvttps_epi32(x);
+                __m256 k = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+                i = _mm256_sub_epi32(i, _mm256_andnot_si256(_mm256_cmpgt_epi32(vsize, i), vsize));
+                __m256i i1 = _mm256_add_epi32(i, _mm256_set1_epi32(1));
+                i1 = _mm256_sub_epi32(i1, _mm256_andnot_si256(_mm256_cmpgt_epi32(vsize, i1), vsize));
+                __m256 a = _mm256_i32gather_ps(buf, i, 4);
+                __m256 b = _mm256_i32gather_ps(buf, i1, 4);
+                _mm256_storeu_ps(out + j, _mm256_add_ps(a, _mm256_mul_ps(k, _mm256_sub_ps(b, a))));
+        }
+#endif
+        for (; j < n; j++)
+                out[j] = qx_ring_interp_linear(buf, index[j], size);
+}
+
+/**
+ * @brief Catmull-Rom interpolation of a block of fractional indices.
+ *
+ * @param buf Pointer to the buffer.
+ * @param size Size of the buffer.
+ * @param index Read indices, one per output sample.
+ * @param out Output samples.
+ * @param n Number of samples.
+ *
+ * Uses AVX2 gathers when available.
+ */
+static inline void qx_ring_read_hermite_block(const float* buf, int size,
+                                              const float* index, float* out, size_t n)
+{
+        size_t j = 0;
+#if defined(QX_SIMD_AVX2)
+        for (; j < (n & ~(size_t)7); j += 8) {
+                __m256 ym1, y0, y1, y2;
+                __m256 k = qx_ring_gather4_avx2(buf, _mm256_loadu_ps(index + j), size,
+                                                &ym1, &y0, &y1, &y2);
+                _mm256_storeu_ps(out + j, qx_interp_hermite4_avx2(ym1, y0, y1, y2, k));
+        }
+#endif
+        for (; j < n; j++)
+                out[j] = qx_ring_interp_hermite(buf, index[j], size);
+}
+
+/**
+ * @brief Lagrange-4 interpolation of a block of fractional indices.
+ *
+ * @param buf Pointer to the buffer.
+ * @param size Size of the buffer.
+ * @param index Read indices, one per output sample.
+ * @param out Output samples.
+ * @param n Number of samples.
+ *
+ * Uses AVX2 gathers when available.
+ */
+static inline void qx_ring_read_lagrange4_block(const float* buf, int size,
+                                                const float* index, float* out, size_t n)
+{
+        size_t j = 0;
+#if defined(QX_SIMD_AVX2)
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 third = _mm256_set1_ps(1.0f / 3.0f);
+        const __m256 sixth = _mm256_set1_ps(1.0f / 6.0f);
+        for (; j < (n & ~(size_t)7); j += 8) {
+                __m256 ym1, y0, y1, y2;
+                __m256 k = qx_ring_gather4_avx2(buf, _mm256_loadu_ps(index + j), size,
+                                                &ym1, &y0, &y1, &y2);
+                __m256 c1 = _mm256_sub_ps(_mm256_sub_ps(y1, _mm256_mul_ps(third, ym1)),
+                                          _mm256_add_ps(_mm256_mul_ps(half, y0),
+                                                        _mm256_mul_ps(sixth, y2)));
+                __m256 c2 = _mm256_sub_ps(_mm256_mul_ps(half, _mm256_add_ps(ym1, y1)), y0);
+                __m256 c3 = _mm256_add_ps(_mm256_mul_ps(sixth, _mm256_sub_ps(y2, ym1)),
+                                          _mm256_mul_ps(half, _mm256_sub_ps(y0, y1)));
+                __m256 r = _mm256_add_ps(_mm256_mul_ps(c3, k), c2);
+                r = _mm256_add_ps(_mm256_mul_ps(r, k), c1);
+                _mm256_storeu_ps(out + j, _mm256_add_ps(_mm256_mul_ps(r, k), y0));
+        }
+#endif
+        for (; j < n; j++)
+                out[j] = qx_ring_interp_lagrange4(buf, index[j], size);
+}
+
+/**
+ * @brief Windowed-sinc interpolation of a block of fractional indices.
+ *
+ * @param table Pointer to an initialized qx_sinc_table.
+ * @param buf Pointer to the buffer.
+ * @param size Size of the buffer.
+ * @param index Read indices, one per output sample.
+ * @param out Output samples.
+ * @param n Number of samples.
+ */
+static inline void qx_ring_read_sinc_block(const struct qx_sinc_table* table,
+                                           const float* buf, int size,
+                                           const float* index, float* out, size_t n)
+{
+        for (size_t j = 0; j < n; j++)
+                out[j] = qx_ring_interp_sinc(table, buf, index[j], size);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_INTERP_H
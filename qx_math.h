@@ -27,6 +27,14 @@
 #ifndef QX_MATH_H
 #define QX_MATH_H
 
+#include "qx_simd.h"
+
+#include <float.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -137,6 +145,302 @@ static inline double qx_clamp_double(double value, double min, double max)
         return QX_CLAMP(value, min, max);
 }
 
+/**
+ * @brief Map an array of floats with out = clamp((in - sub) * mul + add, lo, hi).
+ *
+ * Shared kernel of the normalize, denormalize and clamp array functions.
+ * With @p clamp false the clamp is skipped; the flag is a constant at every
+ * call site, so the unused branch is removed after inlining. NaN inputs
+ * stay NaN, like QX_CLAMP().
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param sub Value subtracted first.
+ * @param mul Scale factor.
+ * @param add Value added last.
+ * @param lo Lower clamp bound.
+ * @param hi Upper clamp bound.
+ * @param clamp Whether to clamp the result.
+ */
+static inline void qx_map_array_float(const float* in, float* out, size_t n,
+                                      float sub, float mul, float add,
+                                      float lo, float hi, bool clamp)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX512)
+        {
+                const __m512 vs = _mm512_set1_ps(sub), vm = _mm512_set1_ps(mul), va = _mm512_set1_ps(add);
+                const __m512 vlo = _mm512_set1_ps(lo), vhi = _mm512_set1_ps(hi);
+                for (; i + 16 <= n; i += 16) {
+                        __m512 v = _mm512_add_ps(_mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm512_min_ps(vhi, _mm512_max_ps(vlo, v));
+                        _mm512_storeu_ps(out + i, v);
+                }
+        }
+#endif
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 vs = _mm256_set1_ps(sub), vm = _mm256_set1_ps(mul), va = _mm256_set1_ps(add);
+                const __m256 vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+                for (; i + 8 <= n; i += 8) {
+                        __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm256_min_ps(vhi, _mm256_max_ps(vlo, v));
+                        _mm256_storeu_ps(out + i, v);
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 vs = _mm_set1_ps(sub), vm = _mm_set1_ps(mul), va = _mm_set1_ps(add);
+                const __m128 vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+                for (; i + 4 <= n; i += 4) {
+                        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm_min_ps(vhi, _mm_max_ps(vlo, v));
+                        _mm_storeu_ps(out + i, v);
+                }
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                const float32x4_t vs = vdupq_n_f32(sub), va = vdupq_n_f32(add);
+                const float32x4_t vlo = vdupq_n_f32(lo), vhi = vdupq_n_f32(hi);
+                for (; i + 4 <= n; i += 4) {
+                        float32x4_t v = vaddq_f32(vmulq_n_f32(vsubq_f32(vld1q_f32(in + i), vs), mul), va);
+                        if (clamp)
+                                v = vminq_f32(vhi, vmaxq_f32(vlo, v));
+                        vst1q_f32(out + i, v);
+                }
+        }
+#endif
+        for (; i < n; i++) {
+                float v = (in[i] - sub) * mul + add;
+                out[i] = clamp ? QX_CLAMP(v, lo, hi) : v;
+        }
+}
+
+/**
+ * @brief Map an array of doubles with out = clamp((in - sub) * mul + add, lo, hi).
+ *
+ * Double version of qx_map_array_float().
+ */
+static inline void qx_map_array_double(const double* in, double* out, size_t n,
+                                       double sub, double mul, double add,
+                                       double lo, double hi, bool clamp)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX512)
+        {
+                const __m512d vs = _mm512_set1_pd(sub), vm = _mm512_set1_pd(mul), va = _mm512_set1_pd(add);
+                const __m512d vlo = _mm512_set1_pd(lo), vhi = _mm512_set1_pd(hi);
+                for (; i + 8 <= n; i += 8) {
+                        __m512d v = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(_mm512_loadu_pd(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm512_min_pd(vhi, _mm512_max_pd(vlo, v));
+                        _mm512_storeu_pd(out + i, v);
+                }
+        }
+#endif
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256d vs = _mm256_set1_pd(sub), vm = _mm256_set1_pd(mul), va = _mm256_set1_pd(add);
+                const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+                for (; i + 4 <= n; i += 4) {
+                        __m256d v = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm256_min_pd(vhi, _mm256_max_pd(vlo, v));
+                        _mm256_storeu_pd(out + i, v);
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128d vs = _mm_set1_pd(sub), vm = _mm_set1_pd(mul), va = _mm_set1_pd(add);
+                const __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+                for (; i + 2 <= n; i += 2) {
+                        __m128d v = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(in + i), vs), vm), va);
+                        if (clamp)
+                                v = _mm_min_pd(vhi, _mm_max_pd(vlo, v));
+                        _mm_storeu_pd(out + i, v);
+                }
+        }
+#elif defined(QX_SIMD_NEON) && defined(__aarch64__)
+        {
+                const float64x2_t vs = vdupq_n_f64(sub), vm = vdupq_n_f64(mul), va = vdupq_n_f64(add);
+                const float64x2_t vlo = vdupq_n_f64(lo), vhi = vdupq_n_f64(hi);
+                for (; i + 2 <= n; i += 2) {
+                        float64x2_t v = vaddq_f64(vmulq_f64(vsubq_f64(vld1q_f64(in + i), vs), vm), va);
+                        if (clamp)
+                                v = vminq_f64(vhi, vmaxq_f64(vlo, v));
+                        vst1q_f64(out + i, v);
+                }
+        }
+#endif
+        for (; i < n; i++) {
+                double v = (in[i] - sub) * mul + add;
+                out[i] = clamp ? QX_CLAMP(v, lo, hi) : v;
+        }
+}
+
+/*
+ * Array versions of the normalize, denormalize and clamp functions.
+ * The output may be the same buffer as the input for in-place use.
+ * Normalization multiplies by the reciprocal of the range, so results
+ * may differ from qx_normalize_float() in the last bit. Denormalization
+ * and clamping give the same results as the scalar functions.
+ */
+
+/**
+ * @brief Normalize an array of floats to the range [0.0, 1.0].
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the original range.
+ * @param max Maximum of the original range.
+ */
+static inline void qx_normalize_array_float(const float* in, float* out, size_t n, float min, float max)
+{
+        qx_map_array_float(in, out, n, min, 1.0f / (max - min), 0.0f, 0.0f, 1.0f, false);
+}
+
+/**
+ * @brief Normalize an array of floats and clamp the result to [0.0, 1.0].
+ *
+ * Single pass equivalent of qx_normalize_array_float() followed by
+ * qx_clamp_array_float(out, out, n, 0.0f, 1.0f).
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the original range.
+ * @param max Maximum of the original range.
+ */
+static inline void qx_normalize_clamp_array_float(const float* in, float* out, size_t n, float min, float max)
+{
+        qx_map_array_float(in, out, n, min, 1.0f / (max - min), 0.0f, 0.0f, 1.0f, true);
+}
+
+/**
+ * @brief Denormalize an array of floats from [0.0, 1.0] to a given range.
+ *
+ * @param in Normalized values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the target range.
+ * @param max Maximum of the target range.
+ */
+static inline void qx_denormalize_array_float(const float* in, float* out, size_t n, float min, float max)
+{
+        qx_map_array_float(in, out, n, 0.0f, max - min, min, min, max, false);
+}
+
+/**
+ * @brief Denormalize an array of floats and clamp the result to the target range.
+ *
+ * Single pass equivalent of qx_denormalize_array_float() followed by
+ * qx_clamp_array_float(). @p min may be greater than @p max for an
+ * inverted range.
+ *
+ * @param in Normalized values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the target range.
+ * @param max Maximum of the target range.
+ */
+static inline void qx_denormalize_clamp_array_float(const float* in, float* out, size_t n, float min, float max)
+{
+        qx_map_array_float(in, out, n, 0.0f, max - min, min,
+                           min < max ? min : max, min < max ? max : min, true);
+}
+
+/**
+ * @brief Clamp an array of floats between min and max.
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum allowed value.
+ * @param max Maximum allowed value.
+ */
+static inline void qx_clamp_array_float(const float* in, float* out, size_t n, float min, float max)
+{
+        qx_map_array_float(in, out, n, 0.0f, 1.0f, 0.0f, min, max, true);
+}
+
+/**
+ * @brief Normalize an array of doubles to the range [0.0, 1.0].
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the original range.
+ * @param max Maximum of the original range.
+ */
+static inline void qx_normalize_array_double(const double* in, double* out, size_t n, double min, double max)
+{
+        qx_map_array_double(in, out, n, min, 1.0 / (max - min), 0.0, 0.0, 1.0, false);
+}
+
+/**
+ * @brief Normalize an array of doubles and clamp the result to [0.0, 1.0].
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the original range.
+ * @param max Maximum of the original range.
+ */
+static inline void qx_normalize_clamp_array_double(const double* in, double* out, size_t n, double min, double max)
+{
+        qx_map_array_double(in, out, n, min, 1.0 / (max - min), 0.0, 0.0, 1.0, true);
+}
+
+/**
+ * @brief Denormalize an array of doubles from [0.0, 1.0] to a given range.
+ *
+ * @param in Normalized values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the target range.
+ * @param max Maximum of the target range.
+ */
+static inline void qx_denormalize_array_double(const double* in, double* out, size_t n, double min, double max)
+{
+        qx_map_array_double(in, out, n, 0.0, max - min, min, min, max, false);
+}
+
+/**
+ * @brief Denormalize an array of doubles and clamp the result to the target range.
+ *
+ * @param in Normalized values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum of the target range.
+ * @param max Maximum of the target range.
+ */
+static inline void qx_denormalize_clamp_array_double(const double* in, double* out, size_t n, double min, double max)
+{
+        qx_map_array_double(in, out, n, 0.0, max - min, min,
+                            min < max ? min : max, min < max ? max : min, true);
+}
+
+/**
+ * @brief Clamp an array of doubles between min and max.
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param min Minimum allowed value.
+ * @param max Maximum allowed value.
+ */
+static inline void qx_clamp_array_double(const double* in, double* out, size_t n, double min, double max)
+{
+        qx_map_array_double(in, out, n, 0.0, 1.0, 0.0, min, max, true);
+}
+
 /**
  * @brief Convert decibels (dB) to linear amplitude.
  *
@@ -165,6 +469,322 @@ static inline float qx_db_to_val(float db)
          return (val > 0.0f) ? (20.0f * log10f(val)) : -INFINITY;
  }
 
+/**
+ * @brief Fast approximation of 2^x.
+ *
+ * Splits x into an integer part, written directly into the float exponent,
+ * and a fraction in [-0.5, 0.5] evaluated with a degree 6 polynomial.
+ * Maximum relative error is 2.4e-7 (a few float ulps).
+ *
+ * @param x Exponent. Values below -126 return 0, values above 127 return +inf,
+ *          NaN returns NaN.
+ * @return Approximation of 2^x.
+ */
+static inline float qx_fast_exp2f(float x)
+{
+        if (x < -126.0f)
+                return 0.0f;
+        if (x > 127.0f)
+                return INFINITY;
+        if (x != x)
+                return x; // NaN, must not reach the integer conversion
+
+        float xi = floorf(x + 0.5f);
+        float f = x - xi;
+        float p = 1.0f + f * (0.6931471806f + f * (0.2402265070f + f * (0.0555041087f
+                  + f * (0.0096181291f + f * (0.0013333558f + f * 0.0001540353f)))));
+
+        int32_t bits = ((int32_t)xi + 127) * (1 << 23);
+        float scale;
+        memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+}
+
+/**
+ * @brief Fast approximation of log2(x).
+ *
+ * Reads the exponent from the float bits and evaluates the mantissa,
+ * centered on [sqrt(0.5), sqrt(2)), with the series
+ * log2(m) = 2/ln(2) * (s + s^3/3 + ... + s^9/9), s = (m - 1) / (m + 1).
+ * The polynomial error is below 1.5e-7; with the final rounding the
+ * maximum absolute error is 4e-6 at the ends of the float range.
+ *
+ * @param x Input value, must be positive. Subnormal values are treated as FLT_MIN.
+ * @return Approximation of log2(x).
+ */
+static inline float qx_fast_log2f(float x)
+{
+        if (x < FLT_MIN)
+                x = FLT_MIN;
+
+        uint32_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        int32_t e = (int32_t)(bits - 0x3f3504f3u) >> 23;
+        bits -= (uint32_t)e << 23;
+
+        float m;
+        memcpy(&m, &bits, sizeof(m));
+        float s = (m - 1.0f) / (m + 1.0f);
+        float s2 = s * s;
+        float p = 2.8853900818f + s2 * (0.9617966939f + s2 * (0.5770780164f
+                  + s2 * (0.4121985831f + s2 * 0.3205988980f)));
+        return (float)e + s * p;
+}
+
+/**
+ * @brief Fast approximation of qx_db_to_val().
+ *
+ * Maximum error is 1.4e-5 dB for inputs in [-200, +60] dB and 2.8e-5 dB
+ * over the whole float range [-758, +764] dB, dominated by the rounding
+ * of the scaled input (qx_db_to_val() has the same limitation).
+ * Lower inputs return 0, higher +inf.
+ *
+ * @param db Value in decibels.
+ * @return Linear amplitude value.
+ */
+static inline float qx_db_to_val_fast(float db)
+{
+        return qx_fast_exp2f(db * 0.1660964047f);
+}
+
+/**
+ * @brief Fast approximation of qx_val_to_db().
+ *
+ * Maximum absolute error is 2.2e-5 dB for values in [-200, +60] dB and
+ * 6.3e-5 dB for every positive normal float. Returns negative infinity
+ * for values less than or equal to zero.
+ *
+ * @param val Linear amplitude value.
+ * @return Value in decibels.
+ */
+static inline float qx_val_to_db_fast(float val)
+{
+        return (val > 0.0f) ? 6.0205999133f * qx_fast_log2f(val) : -INFINITY;
+}
+
+/*
+ * Vector versions of qx_fast_exp2f() and qx_fast_log2f() for the array
+ * conversions. Same polynomials, same error bounds; out-of-range inputs
+ * and NaN are handled with masks instead of branches.
+ */
+#if defined(QX_SIMD_AVX2)
+static inline __m256 qx_fast_exp2_avx2(__m256 x)
+{
+        __m256 under = _mm256_cmp_ps(x, _mm256_set1_ps(-126.0f), _CMP_LT_OQ);
+        __m256 over = _mm256_cmp_ps(x, _mm256_set1_ps(127.0f), _CMP_GT_OQ);
+        __m256 nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+        __m256 in = x;
+        // max/min return the second operand for NaN, so every lane is clamped
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-126.0f)), _mm256_set1_ps(127.0f));
+
+        __m256i xi = _mm256_cvtps_epi32(x);
+        __m256 f = _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi));
+        __m256 p = _mm256_set1_ps(0.0001540353f);
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(0.0013333558f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(0.0096181291f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(0.0555041087f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(0.2402265070f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(0.6931471806f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.0f));
+
+        __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(xi, _mm256_set1_epi32(127)), 23);
+        __m256 r = _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+        r = _mm256_andnot_ps(under, r);
+        r = _mm256_blendv_ps(r, _mm256_set1_ps(INFINITY), over);
+        return _mm256_blendv_ps(r, in, nan);
+}
+
+static inline __m256 qx_fast_log2_avx2(__m256 x)
+{
+        x = _mm256_max_ps(x, _mm256_set1_ps(FLT_MIN));
+        __m256i bits = _mm256_castps_si256(x);
+        __m256i e = _mm256_srai_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(0x3f3504f3)), 23);
+        __m256 m = _mm256_castsi256_ps(_mm256_sub_epi32(bits, _mm256_slli_epi32(e, 23)));
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        __m256 s = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        __m256 s2 = _mm256_mul_ps(s, s);
+        __m256 p = _mm256_set1_ps(0.3205988980f);
+        p = _mm256_add_ps(_mm256_mul_ps(p, s2), _mm256_set1_ps(0.4121985831f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s2), _mm256_set1_ps(0.5770780164f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s2), _mm256_set1_ps(0.9617966939f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s2), _mm256_set1_ps(2.8853900818f));
+        return _mm256_add_ps(_mm256_cvtepi32_ps(e), _mm256_mul_ps(s, p));
+}
+#endif
+
+#if defined(QX_SIMD_SSE2)
+static inline __m128 qx_fast_exp2_sse2(__m128 x)
+{
+        __m128 under = _mm_cmplt_ps(x, _mm_set1_ps(-126.0f));
+        __m128 over = _mm_cmpgt_ps(x, _mm_set1_ps(127.0f));
+        __m128 nan = _mm_cmpunord_ps(x, x);
+        __m128 in = x;
+        // max/min return the second operand for NaN, so every lane is clamped
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.0f)), _mm_set1_ps(127.0f));
+
+        __m128i xi = _mm_cvtps_epi32(x);
+        __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(xi));
+        __m128 p = _mm_set1_ps(0.0001540353f);
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0013333558f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0096181291f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0555041087f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.2402265070f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.6931471806f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+
+        __m128i bits = _mm_slli_epi32(_mm_add_epi32(xi, _mm_set1_epi32(127)), 23);
+        __m128 r = _mm_mul_ps(p, _mm_castsi128_ps(bits));
+        r = _mm_andnot_ps(under, r);
+        r = _mm_or_ps(_mm_and_ps(over, _mm_set1_ps(INFINITY)), _mm_andnot_ps(over, r));
+        return _mm_or_ps(_mm_and_ps(nan, in), _mm_andnot_ps(nan, r));
+}
+
+static inline __m128 qx_fast_log2_sse2(__m128 x)
+{
+        x = _mm_max_ps(x, _mm_set1_ps(FLT_MIN));
+        __m128i bits = _mm_castps_si128(x);
+        __m128i e = _mm_srai_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(0x3f3504f3)), 23);
+        __m128 m = _mm_castsi128_ps(_mm_sub_epi32(bits, _mm_slli_epi32(e, 23)));
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 s = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+        __m128 s2 = _mm_mul_ps(s, s);
+        __m128 p = _mm_set1_ps(0.3205988980f);
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(0.4121985831f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(0.5770780164f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(0.9617966939f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(2.8853900818f));
+        return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(s, p));
+}
+#elif defined(QX_SIMD_NEON)
+static inline float32x4_t qx_fast_exp2_neon(float32x4_t x)
+{
+        uint32x4_t under = vcltq_f32(x, vdupq_n_f32(-126.0f));
+        uint32x4_t over = vcgtq_f32(x, vdupq_n_f32(127.0f));
+        uint32x4_t num = vceqq_f32(x, x);
+        float32x4_t in = x;
+        // vmaxq/vminq propagate NaN, replace it before the conversion
+        x = vbslq_f32(num, x, vdupq_n_f32(0.0f));
+        x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(-126.0f)), vdupq_n_f32(127.0f));
+
+        // floor(x + 0.5): truncate, then correct negative values
+        float32x4_t xh = vaddq_f32(x, vdupq_n_f32(0.5f));
+        int32x4_t xi = vcvtq_s32_f32(xh);
+        xi = vaddq_s32(xi, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(xi), xh)));
+        float32x4_t f = vsubq_f32(x, vcvtq_f32_s32(xi));
+        float32x4_t p = vdupq_n_f32(0.0001540353f);
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.0013333558f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.0096181291f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.0555041087f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.2402265070f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.6931471806f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f));
+
+        int32x4_t bits = vshlq_n_s32(vaddq_s32(xi, vdupq_n_s32(127)), 23);
+        float32x4_t r = vmulq_f32(p, vreinterpretq_f32_s32(bits));
+        r = vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(r), under));
+        r = vbslq_f32(over, vdupq_n_f32(INFINITY), r);
+        return vbslq_f32(num, r, in);
+}
+
+static inline float32x4_t qx_fast_log2_neon(float32x4_t x)
+{
+        x = vmaxq_f32(x, vdupq_n_f32(FLT_MIN));
+        int32x4_t bits = vreinterpretq_s32_f32(x);
+        int32x4_t e = vshrq_n_s32(vsubq_s32(bits, vdupq_n_s32(0x3f3504f3)), 23);
+        float32x4_t m = vreinterpretq_f32_s32(vsubq_s32(bits, vshlq_n_s32(e, 23)));
+
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        float32x4_t den = vaddq_f32(m, one);
+        float32x4_t inv = vrecpeq_f32(den);
+        inv = vmulq_f32(inv, vrecpsq_f32(den, inv));
+        inv = vmulq_f32(inv, vrecpsq_f32(den, inv));
+        float32x4_t s = vmulq_f32(vsubq_f32(m, one), inv);
+        float32x4_t s2 = vmulq_f32(s, s);
+        float32x4_t p = vdupq_n_f32(0.3205988980f);
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(0.4121985831f));
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(0.5770780164f));
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(0.9617966939f));
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(2.8853900818f));
+        return vaddq_f32(vcvtq_f32_s32(e), vmulq_f32(s, p));
+}
+#endif
+
+/**
+ * @brief Convert an array of decibel values to linear amplitudes.
+ *
+ * Vectorized qx_db_to_val_fast(), same error bound.
+ *
+ * @param db Input values in decibels.
+ * @param val Output linear values (may be the same as @p db).
+ * @param n Number of values.
+ */
+static inline void qx_db_to_val_array(const float* db, float* val, size_t n)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+        for (; i + 8 <= n; i += 8) {
+                __m256 x = _mm256_mul_ps(_mm256_loadu_ps(db + i), _mm256_set1_ps(0.1660964047f));
+                _mm256_storeu_ps(val + i, qx_fast_exp2_avx2(x));
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        for (; i + 4 <= n; i += 4) {
+                __m128 x = _mm_mul_ps(_mm_loadu_ps(db + i), _mm_set1_ps(0.1660964047f));
+                _mm_storeu_ps(val + i, qx_fast_exp2_sse2(x));
+        }
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4) {
+                float32x4_t x = vmulq_n_f32(vld1q_f32(db + i), 0.1660964047f);
+                vst1q_f32(val + i, qx_fast_exp2_neon(x));
+        }
+#endif
+        for (; i < n; i++)
+                val[i] = qx_db_to_val_fast(db[i]);
+}
+
+/**
+ * @brief Convert an array of linear amplitudes to decibels.
+ *
+ * Vectorized qx_val_to_db_fast(), same error bound.
+ * Values less than or equal to zero give negative infinity.
+ *
+ * @param val Input linear values.
+ * @param db Output values in decibels (may be the same as @p val).
+ * @param n Number of values.
+ */
+static inline void qx_val_to_db_array(const float* val, float* db, size_t n)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+        for (; i + 8 <= n; i += 8) {
+                __m256 x = _mm256_loadu_ps(val + i);
+                __m256 zero = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LE_OQ);
+                __m256 r = _mm256_mul_ps(qx_fast_log2_avx2(x), _mm256_set1_ps(6.0205999133f));
+                _mm256_storeu_ps(db + i, _mm256_blendv_ps(r, _mm256_set1_ps(-INFINITY), zero));
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        for (; i + 4 <= n; i += 4) {
+                __m128 x = _mm_loadu_ps(val + i);
+                __m128 zero = _mm_cmple_ps(x, _mm_setzero_ps());
+                __m128 r = _mm_mul_ps(qx_fast_log2_sse2(x), _mm_set1_ps(6.0205999133f));
+                _mm_storeu_ps(db + i, _mm_or_ps(_mm_and_ps(zero, _mm_set1_ps(-INFINITY)),
+                                                _mm_andnot_ps(zero, r)));
+        }
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4) {
+                float32x4_t x = vld1q_f32(val + i);
+                uint32x4_t zero = vcleq_f32(x, vdupq_n_f32(0.0f));
+                float32x4_t r = vmulq_n_f32(qx_fast_log2_neon(x), 6.0205999133f);
+                vst1q_f32(db + i, vbslq_f32(zero, vdupq_n_f32(-INFINITY), r));
+        }
+#endif
+        for (; i < n; i++)
+                db[i] = qx_val_to_db_fast(val[i]);
+}
+
 /**
  * @brief Linearly interpolate a value from a circular (ring) buffer.
  *
@@ -183,32 +803,164 @@ static inline float qx_ring_interp_linear(const float *buf,
                                           int size)
 {
         int i1 = (int)index;
-        int i2 = i1 + 1;
+        float k = index - (float)i1;
 
         if (i1 >= size)
                 i1 -= size;
 
+        int i2 = i1 + 1;
         if (i2 >= size)
                 i2 -= size;
 
-        float k = index - (float)i1;
-
         return buf[i1] + k * (buf[i2] - buf[i1]);
 }
 
 /**
  * @brief Wrap a floating-point value into the range [0, max).
  *
+ * Constant time for any input: one division and one floor instead of
+ * repeated subtraction. The result is always in range: NaN, infinite
+ * inputs and values too large to hold a fraction of the period
+ * (about |x| >= 2^23 * max) give 0.
+ *
  * @param x Input value.
- * @param max Upper bound (exclusive).
+ * @param max Upper bound (exclusive), greater than zero.
  * @return Wrapped value.
  */
- static inline float qx_wrapf(float x, float max)
- {
-         while (x < 0.0f) x += max;
-         while (x >= max) x -= max;
-         return x;
- }
+static inline float qx_wrapf(float x, float max)
+{
+        float r = x - max * floorf(x / max);
+
+        // The quotient may round across an integer, fix up by one period
+        r = (r < 0.0f) ? r + max : r;
+        r = (r >= max) ? r - max : r;
+        return (r >= 0.0f && r < max) ? r : 0.0f;
+}
+
+/**
+ * @brief Wrap an array of values into the range [0, max).
+ *
+ * Vectorized qx_wrapf(), same results.
+ *
+ * @param in Input values.
+ * @param out Output values (may be the same as @p in).
+ * @param n Number of values.
+ * @param max Upper bound (exclusive), greater than zero.
+ */
+static inline void qx_wrapf_array(const float* in, float* out, size_t n, float max)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 vmax = _mm256_set1_ps(max);
+                const __m256 zero = _mm256_setzero_ps();
+                for (; i + 8 <= n; i += 8) {
+                        __m256 x = _mm256_loadu_ps(in + i);
+                        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(vmax, _mm256_floor_ps(_mm256_div_ps(x, vmax))));
+                        r = _mm256_add_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_LT_OQ), vmax));
+                        r = _mm256_sub_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, vmax, _CMP_GE_OQ), vmax));
+                        __m256 ok = _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_GE_OQ),
+                                                  _mm256_cmp_ps(r, vmax, _CMP_LT_OQ));
+                        _mm256_storeu_ps(out + i, _mm256_and_ps(r, ok));
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 vmax = _mm_set1_ps(max);
+                const __m128 zero = _mm_setzero_ps();
+                for (; i + 4 <= n; i += 4) {
+                        __m128 x = _mm_loadu_ps(in + i);
+                        __m128 r = _mm_sub_ps(x, _mm_mul_ps(vmax, qx_simd_floor_ps(_mm_div_ps(x, vmax))));
+                        r = _mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, zero), vmax));
+                        r = _mm_sub_ps(r, _mm_and_ps(_mm_cmpge_ps(r, vmax), vmax));
+                        __m128 ok = _mm_and_ps(_mm_cmpge_ps(r, zero), _mm_cmplt_ps(r, vmax));
+                        _mm_storeu_ps(out + i, _mm_and_ps(r, ok));
+                }
+        }
+#elif defined(QX_SIMD_NEON) && defined(__aarch64__)
+        {
+                const float32x4_t vmax = vdupq_n_f32(max);
+                for (; i + 4 <= n; i += 4) {
+                        float32x4_t x = vld1q_f32(in + i);
+                        float32x4_t r = vsubq_f32(x, vmulq_f32(vmax, qx_simd_floor_neon(vdivq_f32(x, vmax))));
+                        uint32x4_t neg = vcltq_f32(r, vdupq_n_f32(0.0f));
+                        r = vaddq_f32(r, vreinterpretq_f32_u32(vandq_u32(neg, vreinterpretq_u32_f32(vmax))));
+                        uint32x4_t over = vcgeq_f32(r, vmax);
+                        r = vsubq_f32(r, vreinterpretq_f32_u32(vandq_u32(over, vreinterpretq_u32_f32(vmax))));
+                        uint32x4_t ok = vandq_u32(vcgeq_f32(r, vdupq_n_f32(0.0f)), vcltq_f32(r, vmax));
+                        vst1q_f32(out + i, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(r), ok)));
+                }
+        }
+#endif
+        for (; i < n; i++)
+                out[i] = qx_wrapf(in[i], max);
+}
+
+/**
+ * @brief Wrap a normalized phase into the range [0, 1).
+ *
+ * @param phase Phase in cycles, any value.
+ * @return Wrapped phase, 0 for NaN or infinite input.
+ */
+static inline float qx_phase_wrap(float phase)
+{
+        return qx_wrapf(phase, 1.0f);
+}
+
+/**
+ * @brief Advance a normalized phase accumulator by one sample.
+ *
+ * @param phase Pointer to the phase in [0, 1).
+ * @param inc Phase increment in cycles per sample (frequency / sample rate),
+ *            may be negative or larger than 1.
+ * @return Phase before the increment.
+ */
+static inline float qx_phase_advance(float* phase, float inc)
+{
+        float p = *phase;
+        *phase = qx_phase_wrap(p + inc);
+        return p;
+}
+
+/** Samples per chunk of qx_phase_fill(); the phase is carried over, and rounded, once per chunk. */
+#define QX_PHASE_CHUNK 64
+
+/**
+ * @brief Fill a buffer with the phase of a constant frequency oscillator.
+ *
+ * out[i] is the phase before the i-th increment, like repeated calls of
+ * qx_phase_advance(). Within each chunk of QX_PHASE_CHUNK samples the
+ * phase is computed from the sample index and wrapped with
+ * qx_wrapf_array(), so there is no loop carried dependency.
+ *
+ * Accuracy: out[i] is within 3 * 2^-19 cycles (5.7e-6) of the chunk
+ * start phase plus the exact i * inc. The start phase of the next chunk
+ * is re-accumulated as p + 64 * inc, which rounds by up to half an ulp
+ * of the sum: 2^-24 cycles while inc < 1/64, 2^-18 in general. This
+ * drift adds up over long blocks, but never exceeds what 64 calls of
+ * qx_phase_advance() can accumulate.
+ *
+ * @param phase Pointer to the phase in [0, 1), updated past the block.
+ * @param inc Phase increment in cycles per sample.
+ * @param out Output phases in [0, 1).
+ * @param n Number of samples.
+ */
+static inline void qx_phase_fill(float* phase, float inc, float* out, size_t n)
+{
+        float p = *phase;
+        inc = qx_phase_wrap(inc);
+        while (n > 0) {
+                size_t chunk = n < QX_PHASE_CHUNK ? n : QX_PHASE_CHUNK;
+                for (size_t i = 0; i < chunk; i++)
+                        out[i] = p + (float)i * inc;
+                qx_wrapf_array(out, out, chunk, 1.0f);
+                p = qx_phase_wrap(p + (float)chunk * inc);
+                out += chunk;
+                n -= chunk;
+        }
+        *phase = p;
+}
 
 #ifdef __cplusplus
 }
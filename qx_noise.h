@@ -0,0 +1,368 @@
+/**
+ * @file qx_noise.h
+ * @brief White, pink, brown, blue and velvet noise generators.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_NOISE_H
+#define QX_NOISE_H
+
+#include "qx_math.h"
+#include "qx_randomizer.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Noise colors.
+ */
+enum qx_noise_color {
+        /** Uniform white noise in [-1, 1). */
+        QX_NOISE_WHITE = 0,
+        /** Voss-McCartney pink noise, -3 dB/octave, in [-1, 1). */
+        QX_NOISE_PINK,
+        /** Leaky integrated white noise, -6 dB/octave above QX_NOISE_BROWN_CUTOFF, RMS 0.25. */
+        QX_NOISE_BROWN,
+        /** Differentiated pink noise, +3 dB/octave, in (-1, 1). */
+        QX_NOISE_BLUE,
+        /** Velvet noise: one impulse of +1 or -1 at a random position in every period. */
+        QX_NOISE_VELVET,
+};
+
+/** Number of octave rows of the pink noise generator. */
+#define QX_NOISE_PINK_ROWS 16
+
+/** Corner frequency in Hz below which brown noise is flat. */
+#define QX_NOISE_BROWN_CUTOFF 10.0f
+
+/** Default velvet noise density in impulses per second. */
+#define QX_NOISE_VELVET_DENSITY 2000.0f
+
+/**
+ * @brief Noise generator state.
+ *
+ * Every color draws its raw values from an embedded qx_randomizer, so a
+ * generator seeded with qx_noise_set_seed() always produces the same
+ * signal, whether it is read per sample or in blocks.
+ *
+ * @note Not thread-safe.
+ */
+struct qx_noise {
+        enum qx_noise_color color;       /**< Noise color */
+        struct qx_randomizer rand;       /**< Source of raw values */
+        float sample_rate;               /**< Sample rate in Hz */
+
+        int32_t rows[QX_NOISE_PINK_ROWS]; /**< Pink: held values of the octave rows */
+        int32_t sum;                     /**< Pink: sum of the rows, exact */
+        uint32_t counter;                /**< Pink: sample counter selecting the row to update */
+
+        float state;                     /**< Brown: integrator; blue: previous pink value */
+        float leak;                      /**< Brown: integrator feedback */
+        float gain;                      /**< Brown: input gain */
+
+        uint32_t period;                 /**< Velvet: impulse spacing in samples */
+        uint32_t position;               /**< Velvet: position in the current period */
+        uint32_t impulse;                /**< Velvet: impulse position in the current period */
+        float sign;                      /**< Velvet: impulse sign */
+};
+
+/**
+ * @brief Map a raw value to a uniform float in [-1, 1).
+ */
+static inline float qx_noise_white_value(uint32_t u)
+{
+        return (float)(int32_t)u * (1.0f / 2147483648.0f);
+}
+
+/**
+ * @brief Count trailing zero bits.
+ *
+ * @param x Value, must not be 0.
+ * @return Index of the lowest set bit.
+ */
+static inline uint32_t qx_noise_ctz32(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+        return (uint32_t)__builtin_ctz(x);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return (uint32_t)index;
+#else
+        uint32_t n = 0;
+        while (!(x & 1u)) {
+                x >>= 1;
+                n++;
+        }
+        return n;
+#endif
+}
+
+static inline void qx_noise_reset(struct qx_noise* noise)
+{
+        noise->sum = 0;
+        for (int i = 0; i < QX_NOISE_PINK_ROWS; i++) {
+                noise->rows[i] = (int32_t)qx_randomizer_next_u32(&noise->rand) >> 5;
+                noise->sum += noise->rows[i];
+        }
+        noise->counter = 0;
+        noise->state = 0.0f;
+        noise->position = 0;
+        noise->impulse = 0;
+        noise->sign = 0.0f;
+}
+
+/**
+ * @brief Set the seed of a noise generator and restart it.
+ *
+ * @param noise Pointer to an initialized noise generator.
+ * @param seed Seed; the same seed always gives the same signal.
+ */
+static inline void qx_noise_set_seed(struct qx_noise* noise, uint32_t seed)
+{
+        qx_randomizer_init_seed(&noise->rand, NULL, QX_RANDOM_ENGINE_LCG, seed, -1.0f, 1.0f, 1.0f);
+        qx_noise_reset(noise);
+}
+
+/**
+ * @brief Set the velvet noise density.
+ *
+ * @param noise Pointer to an initialized noise generator.
+ * @param density Impulses per second, rounded to an integer period in samples.
+ */
+static inline void qx_noise_set_density(struct qx_noise* noise, float density)
+{
+        float period = density > 0.0f ? noise->sample_rate / density + 0.5f : 1.0f;
+        noise->period = period < 1.0f ? 1u : period > 4294967040.0f ? 4294967040u : (uint32_t)period;
+        if (noise->position >= noise->period)
+                noise->position = 0;
+}
+
+/**
+ * @brief Initialize a noise generator.
+ *
+ * Takes a unique seed from the process-wide seed source, like
+ * qx_randomizer_init(); use qx_noise_set_seed() for a reproducible signal.
+ *
+ * @param noise Pointer to qx_noise struct.
+ * @param color Noise color.
+ * @param sample_rate Sample rate in Hz.
+ */
+static inline void qx_noise_init(struct qx_noise* noise, enum qx_noise_color color, float sample_rate)
+{
+        noise->color = color;
+        noise->sample_rate = sample_rate;
+
+        // Brown: one pole at the cutoff, gain for an RMS of 0.25 (white variance is 1/3)
+        noise->leak = 1.0f - 2.0f * (float)M_PI * QX_NOISE_BROWN_CUTOFF / sample_rate;
+        if (noise->leak < 0.0f)
+                noise->leak = 0.0f;
+        noise->gain = 0.25f * sqrtf(3.0f * (1.0f - noise->leak * noise->leak));
+
+        noise->period = 1;
+        noise->position = 0;
+        qx_noise_set_density(noise, QX_NOISE_VELVET_DENSITY);
+
+        qx_randomizer_init(&noise->rand, -1.0f, 1.0f, 1.0f);
+        qx_noise_reset(noise);
+}
+
+/*
+ * Pink noise (Voss-McCartney): row k is redrawn every 2^(k+1) samples,
+ * on the samples whose counter has k trailing zeros, so every sample
+ * updates at most one row. The rows are integers, so the running sum
+ * has no rounding drift. Each sample draws two raw values: the row value
+ * and a white component.
+ */
+static inline float qx_noise_pink_step(struct qx_noise* noise, uint32_t row_value, uint32_t white)
+{
+        uint32_t c = ++noise->counter & ((1u << QX_NOISE_PINK_ROWS) - 1u);
+        if (c != 0) {
+                uint32_t k = qx_noise_ctz32(c);
+                int32_t v = (int32_t)row_value >> 5;
+                noise->sum += v - noise->rows[k];
+                noise->rows[k] = v;
+        }
+        return (float)(noise->sum + ((int32_t)white >> 5))
+               * (1.0f / ((QX_NOISE_PINK_ROWS + 1) * 67108864.0f));
+}
+
+/*
+ * Brown noise: one-pole leaky integrator. Shared by the per-sample and
+ * block paths so both round the same way.
+ */
+static inline float qx_noise_brown_step(float leak, float gain, float y, float white)
+{
+        float in = gain * white;
+        return leak * y + in;
+}
+
+/*
+ * Velvet noise: at the start of every period, draw the impulse position
+ * from the high bits of one raw value and its sign from the top bit of
+ * another.
+ */
+static inline void qx_noise_velvet_draw(struct qx_noise* noise)
+{
+        uint32_t u = qx_randomizer_next_u32(&noise->rand);
+        uint32_t s = qx_randomizer_next_u32(&noise->rand);
+        noise->impulse = (uint32_t)(((uint64_t)u * noise->period) >> 32);
+        noise->sign = (s & 0x80000000u) ? -1.0f : 1.0f;
+}
+
+static inline float qx_noise_velvet_step(struct qx_noise* noise)
+{
+        if (noise->position == 0)
+                qx_noise_velvet_draw(noise);
+
+        float out = noise->position == noise->impulse ? noise->sign : 0.0f;
+        if (++noise->position == noise->period)
+                noise->position = 0;
+        return out;
+}
+
+/**
+ * @brief Generate the next noise sample.
+ *
+ * @param noise Pointer to an initialized noise generator.
+ * @return Noise sample.
+ */
+static inline float qx_noise_next(struct qx_noise* noise)
+{
+        switch (noise->color) {
+        case QX_NOISE_PINK:
+        {
+                uint32_t row = qx_randomizer_next_u32(&noise->rand);
+                return qx_noise_pink_step(noise, row, qx_randomizer_next_u32(&noise->rand));
+        }
+        case QX_NOISE_BROWN:
+                noise->state = qx_noise_brown_step(noise->leak, noise->gain, noise->state,
+                                                   qx_noise_white_value(qx_randomizer_next_u32(&noise->rand)));
+                return noise->state;
+        case QX_NOISE_BLUE:
+        {
+                uint32_t row = qx_randomizer_next_u32(&noise->rand);
+                float pink = qx_noise_pink_step(noise, row, qx_randomizer_next_u32(&noise->rand));
+                float out = 4.0f * (pink - noise->state);
+                noise->state = pink;
+                return out;
+        }
+        case QX_NOISE_VELVET:
+                return qx_noise_velvet_step(noise);
+        case QX_NOISE_WHITE:
+        default:
+                return qx_noise_white_value(qx_randomizer_next_u32(&noise->rand));
+        }
+}
+
+/**
+ * @brief Fill a buffer with noise.
+ *
+ * Same samples, and same final state, as calling qx_noise_next() `n`
+ * times. The raw values are generated in chunks with
+ * qx_randomizer_fill_u32() and converted in vectorizable loops; the pink
+ * row updates and the brown integrator run per sample. Velvet noise
+ * clears the buffer and only writes the impulses.
+ *
+ * @param noise Pointer to an initialized noise generator.
+ * @param out Output buffer.
+ * @param n Number of samples.
+ */
+static inline void qx_noise_fill(struct qx_noise* noise, float* out, size_t n)
+{
+        if (noise->color == QX_NOISE_VELVET) {
+                size_t i = 0;
+                while (i < n) {
+                        if (noise->position == 0)
+                                qx_noise_velvet_draw(noise);
+
+                        size_t len = noise->period - noise->position;
+                        if (len > n - i)
+                                len = n - i;
+                        memset(out + i, 0, len * sizeof(float));
+                        if (noise->impulse >= noise->position && noise->impulse - noise->position < len)
+                                out[i + noise->impulse - noise->position] = noise->sign;
+
+                        noise->position += (uint32_t)len;
+                        if (noise->position == noise->period)
+                                noise->position = 0;
+                        i += len;
+                }
+                return;
+        }
+
+        bool pink = noise->color == QX_NOISE_PINK || noise->color == QX_NOISE_BLUE;
+        size_t chunk = pink ? QX_RANDOMIZER_CHUNK / 2 : QX_RANDOMIZER_CHUNK;
+        uint32_t raw[QX_RANDOMIZER_CHUNK];
+        for (size_t pos = 0; pos < n; pos += chunk) {
+                size_t count = n - pos;
+                if (count > chunk)
+                        count = chunk;
+                float* dst = out + pos;
+
+                if (pink) {
+                        qx_randomizer_fill_u32(&noise->rand, raw, 2 * count);
+                        for (size_t i = 0; i < count; i++)
+                                dst[i] = qx_noise_pink_step(noise, raw[2 * i], raw[2 * i + 1]);
+                        if (noise->color == QX_NOISE_BLUE) {
+                                float prev = noise->state;
+                                noise->state = dst[count - 1];
+                                for (size_t i = count - 1; i > 0; i--)
+                                        dst[i] = 4.0f * (dst[i] - dst[i - 1]);
+                                dst[0] = 4.0f * (dst[0] - prev);
+                        }
+                        continue;
+                }
+
+                qx_randomizer_fill_u32(&noise->rand, raw, count);
+                for (size_t i = 0; i < count; i++)
+                        dst[i] = qx_noise_white_value(raw[i]);
+
+                if (noise->color == QX_NOISE_BROWN) {
+                        float y = noise->state;
+                        const float leak = noise->leak;
+                        const float gain = noise->gain;
+                        for (size_t i = 0; i < count; i++) {
+                                y = qx_noise_brown_step(leak, gain, y, dst[i]);
+                                dst[i] = y;
+                        }
+                        noise->state = y;
+                }
+        }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QX_NOISE_H
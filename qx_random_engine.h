@@ -0,0 +1,831 @@
+/**
+ * @file qx_random_engine.h
+ * @brief Pseudo-random number engines with scalar and SIMD bulk generation.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_RANDOM_ENGINE_H
+#define QX_RANDOM_ENGINE_H
+
+#include "qx_math.h"
+#include "qx_simd.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Available pseudo-random engines.
+ *
+ * All engines produce 32-bit values. For every engine the bulk fill
+ * produces exactly the same sequence as repeated calls to
+ * qx_random_engine_next().
+ */
+enum qx_random_engine_type {
+        /** 32-bit LCG. Fastest, weak low bits, period 2^32. */
+        QX_RANDOM_ENGINE_LCG = 0,
+        /** Eight interleaved xoshiro128+ streams. Period 2^128 - 1 per stream. */
+        QX_RANDOM_ENGINE_XOSHIRO128P,
+        /** PCG32 (XSH-RR). 64-bit state, period 2^64. */
+        QX_RANDOM_ENGINE_PCG32,
+        /** SplitMix-style hash of a 64-bit counter. Stateless, seekable. */
+        QX_RANDOM_ENGINE_SPLITMIX,
+        /** Philox4x32-10 counter-based generator. Stateless, seekable, highest quality. */
+        QX_RANDOM_ENGINE_PHILOX,
+};
+
+/**
+ * @brief Number of interleaved xoshiro128+ streams.
+ */
+#define QX_XOSHIRO_LANES 8
+
+/**
+ * @brief Pseudo-random engine state.
+ *
+ * The layout of `state` depends on the engine type:
+ * - LCG: state[0].
+ * - xoshiro128+: word w of lane l at state[w * QX_XOSHIRO_LANES + l].
+ * - PCG32: 64-bit state in state[0] (low) and state[1] (high), the odd
+ *   stream increment in state[2] (low) and state[3] (high).
+ * - SplitMix and Philox: key in state[0] and state[1].
+ *
+ * `counter` is the number of values generated so far.
+ *
+ * @note Not thread-safe.
+ */
+struct qx_random_engine {
+        enum qx_random_engine_type type; /**< Engine type. */
+        uint32_t state[4 * QX_XOSHIRO_LANES]; /**< Engine state. */
+        uint64_t counter;                /**< Number of generated values. */
+};
+
+/**
+ * @brief Multiplier of the linear congruential generator.
+ */
+#define QX_LCG_MUL 1664525u
+
+/**
+ * @brief Increment of the linear congruential generator.
+ */
+#define QX_LCG_INC 1013904223u
+
+/**
+ * @brief Computes the LCG constants that advance the seed by several steps at once.
+ *
+ * Advancing the seed `steps` times is equivalent to
+ * `seed = seed * mul + inc` with the returned constants.
+ * Runs in O(log steps).
+ *
+ * @param steps Number of steps to jump ahead.
+ * @param mul Returned multiplier.
+ * @param inc Returned increment.
+ */
+static inline void qx_lcg_jump(uint64_t steps, uint32_t* mul, uint32_t* inc)
+{
+        uint32_t acc_mul = 1u;
+        uint32_t acc_inc = 0u;
+        uint32_t cur_mul = QX_LCG_MUL;
+        uint32_t cur_inc = QX_LCG_INC;
+
+        while (steps > 0) {
+                if (steps & 1u) {
+                        acc_mul *= cur_mul;
+                        acc_inc = acc_inc * cur_mul + cur_inc;
+                }
+                cur_inc = (cur_mul + 1u) * cur_inc;
+                cur_mul *= cur_mul;
+                steps >>= 1;
+        }
+
+        *mul = acc_mul;
+        *inc = acc_inc;
+}
+
+#define QX_PCG32_MUL 6364136223846793005ull
+#define QX_PCG32_INC 1442695040888963407ull
+
+#define QX_PHILOX_M0 0xd2511f53u
+#define QX_PHILOX_M1 0xcd9e8d57u
+#define QX_PHILOX_W0 0x9e3779b9u
+#define QX_PHILOX_W1 0xbb67ae85u
+
+/**
+ * @brief MurmurHash3 32-bit finalizer.
+ *
+ * @param z Input value.
+ * @return Well mixed 32-bit value.
+ */
+static inline uint32_t qx_fmix32(uint32_t z)
+{
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        return z ^ (z >> 16);
+}
+
+static inline uint32_t qx_rotl32(uint32_t x, int k)
+{
+        return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t qx_rotr32(uint32_t x, unsigned int k)
+{
+        return (x >> k) | (x << ((32u - k) & 31u));
+}
+
+/**
+ * @brief Computes the PCG32 constants that advance the state by several steps at once.
+ *
+ * @param steps Number of steps to jump ahead.
+ * @param stream_inc Increment of the PCG32 stream.
+ * @param mul Returned multiplier.
+ * @param inc Returned increment.
+ */
+static inline void qx_pcg32_jump(uint64_t steps, uint64_t stream_inc, uint64_t* mul, uint64_t* inc)
+{
+        uint64_t acc_mul = 1u;
+        uint64_t acc_inc = 0u;
+        uint64_t cur_mul = QX_PCG32_MUL;
+        uint64_t cur_inc = stream_inc;
+
+        while (steps > 0) {
+                if (steps & 1u) {
+                        acc_mul *= cur_mul;
+                        acc_inc = acc_inc * cur_mul + cur_inc;
+                }
+                cur_inc = (cur_mul + 1u) * cur_inc;
+                cur_mul *= cur_mul;
+                steps >>= 1;
+        }
+
+        *mul = acc_mul;
+        *inc = acc_inc;
+}
+
+/**
+ * @brief SplitMix counter hash.
+ *
+ * @param k0 First key word.
+ * @param k1 Second key word.
+ * @param counter Sample index.
+ * @return 32-bit random value for the given key and index.
+ */
+static inline uint32_t qx_splitmix_hash(uint32_t k0, uint32_t k1, uint64_t counter)
+{
+        uint32_t base = k0 ^ qx_fmix32(k1 + (uint32_t)(counter >> 32));
+        return qx_fmix32(base + ((uint32_t)counter + 1u) * 0x9e3779b9u);
+}
+
+/**
+ * @brief Philox4x32-10 block function.
+ *
+ * @param k0 First key word.
+ * @param k1 Second key word.
+ * @param block 64-bit block counter.
+ * @param out Four 32-bit random values.
+ */
+static inline void qx_philox4x32(uint32_t k0, uint32_t k1, uint64_t block, uint32_t out[4])
+{
+        uint32_t c0 = (uint32_t)block;
+        uint32_t c1 = (uint32_t)(block >> 32);
+        uint32_t c2 = 0u;
+        uint32_t c3 = 0u;
+
+        for (int r = 0; r < 10; r++) {
+                uint64_t p0 = (uint64_t)QX_PHILOX_M0 * c0;
+                uint64_t p1 = (uint64_t)QX_PHILOX_M1 * c2;
+                uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+                uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+                c1 = (uint32_t)p1;
+                c3 = (uint32_t)p0;
+                c0 = n0;
+                c2 = n2;
+                k0 += QX_PHILOX_W0;
+                k1 += QX_PHILOX_W1;
+        }
+
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+}
+
+/**
+ * @brief Seeds an engine.
+ *
+ * @param eng Pointer to the engine.
+ * @param type Engine type.
+ * @param seed 32-bit seed. The full engine state is expanded from it
+ *             with a SplitMix32 sequence.
+ */
+static inline void qx_random_engine_seed(struct qx_random_engine* eng,
+                                         enum qx_random_engine_type type,
+                                         uint32_t seed)
+{
+        eng->type = type;
+        eng->counter = 0;
+        for (size_t i = 0; i < QX_ARRAY_SIZE(eng->state); i++)
+                eng->state[i] = qx_fmix32(seed + (uint32_t)(i + 1) * 0x9e3779b9u);
+
+        switch (type) {
+        case QX_RANDOM_ENGINE_LCG:
+                eng->state[0] = seed;
+                break;
+        case QX_RANDOM_ENGINE_XOSHIRO128P:
+                // An all-zero lane would only ever produce zeros
+                for (size_t l = 0; l < QX_XOSHIRO_LANES; l++) {
+                        if ((eng->state[l] | eng->state[QX_XOSHIRO_LANES + l]
+                             | eng->state[2 * QX_XOSHIRO_LANES + l]
+                             | eng->state[3 * QX_XOSHIRO_LANES + l]) == 0)
+                                eng->state[l] = 1u;
+                }
+                break;
+        case QX_RANDOM_ENGINE_PCG32:
+        {
+                // pcg32_srandom(): step, add the seed, step
+                uint64_t init = ((uint64_t)eng->state[1] << 32) | eng->state[0];
+                uint64_t s = QX_PCG32_INC;
+                s += init;
+                s = s * QX_PCG32_MUL + QX_PCG32_INC;
+                eng->state[0] = (uint32_t)s;
+                eng->state[1] = (uint32_t)(s >> 32);
+                eng->state[2] = (uint32_t)QX_PCG32_INC;
+                eng->state[3] = (uint32_t)(QX_PCG32_INC >> 32);
+                break;
+        }
+        default:
+                break;
+        }
+}
+
+/**
+ * @brief Seeds a PCG32 engine like the reference pcg32_srandom().
+ *
+ * @param eng Pointer to the engine.
+ * @param initstate Starting state.
+ * @param initseq Stream selector; different values give different,
+ *                non-overlapping sequences.
+ *
+ * Produces the same values as the PCG32 reference implementation.
+ * qx_random_engine_seed() uses a fixed stream.
+ */
+static inline void qx_random_engine_seed_pcg32(struct qx_random_engine* eng,
+                                               uint64_t initstate,
+                                               uint64_t initseq)
+{
+        eng->type = QX_RANDOM_ENGINE_PCG32;
+        eng->counter = 0;
+        memset(eng->state, 0, sizeof(eng->state));
+
+        uint64_t inc = (initseq << 1) | 1u;
+        uint64_t s = inc;
+        s += initstate;
+        s = s * QX_PCG32_MUL + inc;
+        eng->state[0] = (uint32_t)s;
+        eng->state[1] = (uint32_t)(s >> 32);
+        eng->state[2] = (uint32_t)inc;
+        eng->state[3] = (uint32_t)(inc >> 32);
+}
+
+/**
+ * @brief Generates the next 32-bit value.
+ *
+ * @param eng Pointer to a seeded engine.
+ * @return 32-bit random value.
+ */
+static inline uint32_t qx_random_engine_next(struct qx_random_engine* eng)
+{
+        uint64_t n = eng->counter++;
+
+        switch (eng->type) {
+        case QX_RANDOM_ENGINE_XOSHIRO128P:
+        {
+                uint32_t* s = eng->state + (n % QX_XOSHIRO_LANES);
+                uint32_t s0 = s[0];
+                uint32_t s1 = s[QX_XOSHIRO_LANES];
+                uint32_t s2 = s[2 * QX_XOSHIRO_LANES];
+                uint32_t s3 = s[3 * QX_XOSHIRO_LANES];
+                uint32_t result = s0 + s3;
+                uint32_t t = s1 << 9;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = qx_rotl32(s3, 11);
+                s[0] = s0;
+                s[QX_XOSHIRO_LANES] = s1;
+                s[2 * QX_XOSHIRO_LANES] = s2;
+                s[3 * QX_XOSHIRO_LANES] = s3;
+                return result;
+        }
+        case QX_RANDOM_ENGINE_PCG32:
+        {
+                uint64_t old = ((uint64_t)eng->state[1] << 32) | eng->state[0];
+                uint64_t inc = ((uint64_t)eng->state[3] << 32) | eng->state[2];
+                uint64_t s = old * QX_PCG32_MUL + inc;
+                eng->state[0] = (uint32_t)s;
+                eng->state[1] = (uint32_t)(s >> 32);
+                uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+                return qx_rotr32(xorshifted, (unsigned int)(old >> 59));
+        }
+        case QX_RANDOM_ENGINE_SPLITMIX:
+                return qx_splitmix_hash(eng->state[0], eng->state[1], n);
+        case QX_RANDOM_ENGINE_PHILOX:
+        {
+                uint32_t block[4];
+                qx_philox4x32(eng->state[0], eng->state[1], n >> 2, block);
+                return block[n & 3];
+        }
+        case QX_RANDOM_ENGINE_LCG:
+        default:
+                eng->state[0] = eng->state[0] * QX_LCG_MUL + QX_LCG_INC;
+                return eng->state[0];
+        }
+}
+
+#if defined(QX_SIMD_AVX2)
+static inline __m256i qx_simd_mullo_epi64_avx2(__m256i a, __m256i b)
+{
+        __m256i lo = _mm256_mul_epu32(a, b);
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                         _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+static inline __m256i qx_pcg32_output_avx2(__m256i old)
+{
+        __m256i x = _mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(old, 18), old), 27);
+        x = _mm256_and_si256(x, _mm256_set1_epi64x(0xffffffffll));
+        __m256i rot = _mm256_srli_epi64(old, 59);
+        __m256i lrot = _mm256_and_si256(_mm256_sub_epi64(_mm256_set1_epi64x(32), rot),
+                                        _mm256_set1_epi64x(31));
+        return _mm256_or_si256(_mm256_srlv_epi64(x, rot), _mm256_sllv_epi64(x, lrot));
+}
+#endif
+
+/*
+ * Per-ISA helpers for the Philox and SplitMix bulk paths.
+ * mulhilo computes the full 64-bit products of every 32-bit lane with m.
+ */
+#if defined(QX_SIMD_AVX2)
+typedef __m256i qx_rng_vec;
+#define QX_RNG_VEC_LANES 8
+#define qx_rng_set1(x) _mm256_set1_epi32((int)(x))
+#define qx_rng_add(a, b) _mm256_add_epi32(a, b)
+#define qx_rng_xor(a, b) _mm256_xor_si256(a, b)
+#define qx_rng_mullo(a, b) _mm256_mullo_epi32(a, b)
+#define qx_rng_srli(a, k) _mm256_srli_epi32(a, k)
+#define qx_rng_store(p, a) _mm256_storeu_si256((__m256i*)(p), a)
+static inline qx_rng_vec qx_rng_iota(uint32_t start)
+{
+        return _mm256_add_epi32(_mm256_set1_epi32((int)start),
+                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+static inline void qx_rng_mulhilo(qx_rng_vec a, uint32_t m, qx_rng_vec* hi, qx_rng_vec* lo)
+{
+        const __m256i vm = _mm256_set1_epi32((int)m);
+        const __m256i mask = _mm256_set1_epi64x(0xffffffffll);
+        __m256i even = _mm256_mul_epu32(a, vm);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), vm);
+        *lo = _mm256_or_si256(_mm256_and_si256(even, mask), _mm256_slli_epi64(odd, 32));
+        *hi = _mm256_or_si256(_mm256_srli_epi64(even, 32), _mm256_andnot_si256(mask, odd));
+}
+#elif defined(QX_SIMD_SSE2)
+typedef __m128i qx_rng_vec;
+#define QX_RNG_VEC_LANES 4
+#define qx_rng_set1(x) _mm_set1_epi32((int)(x))
+#define qx_rng_add(a, b) _mm_add_epi32(a, b)
+#define qx_rng_xor(a, b) _mm_xor_si128(a, b)
+#define qx_rng_mullo(a, b) qx_simd_mullo_epi32(a, b)
+#define qx_rng_srli(a, k) _mm_srli_epi32(a, k)
+#define qx_rng_store(p, a) _mm_storeu_si128((__m128i*)(p), a)
+static inline qx_rng_vec qx_rng_iota(uint32_t start)
+{
+        return _mm_add_epi32(_mm_set1_epi32((int)start), _mm_setr_epi32(0, 1, 2, 3));
+}
+static inline void qx_rng_mulhilo(qx_rng_vec a, uint32_t m, qx_rng_vec* hi, qx_rng_vec* lo)
+{
+        const __m128i vm = _mm_set1_epi32((int)m);
+        const __m128i mask = _mm_set1_epi64x(0xffffffffll);
+        __m128i even = _mm_mul_epu32(a, vm);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), vm);
+        *lo = _mm_or_si128(_mm_and_si128(even, mask), _mm_slli_epi64(odd, 32));
+        *hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(mask, odd));
+}
+#elif defined(QX_SIMD_NEON)
+typedef uint32x4_t qx_rng_vec;
+#define QX_RNG_VEC_LANES 4
+#define qx_rng_set1(x) vdupq_n_u32(x)
+#define qx_rng_add(a, b) vaddq_u32(a, b)
+#define qx_rng_xor(a, b) veorq_u32(a, b)
+#define qx_rng_mullo(a, b) vmulq_u32(a, b)
+#define qx_rng_srli(a, k) vshrq_n_u32(a, k)
+#define qx_rng_store(p, a) vst1q_u32(p, a)
+static inline qx_rng_vec qx_rng_iota(uint32_t start)
+{
+        const uint32_t offs[4] = {0u, 1u, 2u, 3u};
+        return vaddq_u32(vdupq_n_u32(start), vld1q_u32(offs));
+}
+static inline void qx_rng_mulhilo(qx_rng_vec a, uint32_t m, qx_rng_vec* hi, qx_rng_vec* lo)
+{
+        uint64x2_t p0 = vmull_n_u32(vget_low_u32(a), m);
+        uint64x2_t p1 = vmull_n_u32(vget_high_u32(a), m);
+        uint32x4x2_t parts = vuzpq_u32(vreinterpretq_u32_u64(p0), vreinterpretq_u32_u64(p1));
+        *lo = parts.val[0];
+        *hi = parts.val[1];
+}
+#endif
+
+#if defined(QX_RNG_VEC_LANES)
+static inline qx_rng_vec qx_rng_fmix32(qx_rng_vec z)
+{
+        z = qx_rng_mullo(qx_rng_xor(z, qx_rng_srli(z, 16)), qx_rng_set1(0x85ebca6bu));
+        z = qx_rng_mullo(qx_rng_xor(z, qx_rng_srli(z, 13)), qx_rng_set1(0xc2b2ae35u));
+        return qx_rng_xor(z, qx_rng_srli(z, 16));
+}
+
+/**
+ * @brief Stores four Philox word vectors as consecutive blocks.
+ *
+ * Lane l of c[w] is word w of block l; the output is block-major.
+ */
+static inline void qx_rng_store_blocks(uint32_t* out, qx_rng_vec c0, qx_rng_vec c1,
+                                       qx_rng_vec c2, qx_rng_vec c3)
+{
+#if defined(QX_SIMD_AVX2)
+        __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+        __m256i t1 = _mm256_unpacklo_epi32(c2, c3);
+        __m256i t2 = _mm256_unpackhi_epi32(c0, c1);
+        __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+        __m256i r0 = _mm256_unpacklo_epi64(t0, t1);
+        __m256i r1 = _mm256_unpackhi_epi64(t0, t1);
+        __m256i r2 = _mm256_unpacklo_epi64(t2, t3);
+        __m256i r3 = _mm256_unpackhi_epi64(t2, t3);
+        _mm256_storeu_si256((__m256i*)out, _mm256_permute2x128_si256(r0, r1, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + 8), _mm256_permute2x128_si256(r2, r3, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + 16), _mm256_permute2x128_si256(r0, r1, 0x31));
+        _mm256_storeu_si256((__m256i*)(out + 24), _mm256_permute2x128_si256(r2, r3, 0x31));
+#elif defined(QX_SIMD_SSE2)
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+        __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+        __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+        _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi64(t2, t3));
+#else
+        uint32x4x4_t v = {{c0, c1, c2, c3}};
+        vst4q_u32(out, v);
+#endif
+}
+#endif
+
+/**
+ * @brief Fills a buffer with 32-bit random values.
+ *
+ * @param eng Pointer to a seeded engine.
+ * @param out Output buffer.
+ * @param n Number of values.
+ *
+ * Produces the same values as calling qx_random_engine_next() `n` times.
+ * xoshiro128+, SplitMix and Philox are vectorized with SSE2/AVX2/NEON,
+ * PCG32 with AVX2. The LCG is generated serially; qx_randomizer_fill()
+ * has the vectorized LCG path.
+ */
+static inline void qx_random_engine_fill_u32(struct qx_random_engine* eng,
+                                             uint32_t* out,
+                                             size_t n)
+{
+        size_t i = 0;
+
+        switch (eng->type) {
+        case QX_RANDOM_ENGINE_XOSHIRO128P:
+        {
+                while (i < n && eng->counter % QX_XOSHIRO_LANES != 0)
+                        out[i++] = qx_random_engine_next(eng);
+
+                size_t start = i;
+#if defined(QX_SIMD_AVX2)
+                uint32_t* st = eng->state;
+                __m256i s0 = _mm256_loadu_si256((const __m256i*)st);
+                __m256i s1 = _mm256_loadu_si256((const __m256i*)(st + 8));
+                __m256i s2 = _mm256_loadu_si256((const __m256i*)(st + 16));
+                __m256i s3 = _mm256_loadu_si256((const __m256i*)(st + 24));
+                for (; i + 8 <= n; i += 8) {
+                        _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi32(s0, s3));
+                        __m256i t = _mm256_slli_epi32(s1, 9);
+                        s2 = _mm256_xor_si256(s2, s0);
+                        s3 = _mm256_xor_si256(s3, s1);
+                        s1 = _mm256_xor_si256(s1, s2);
+                        s0 = _mm256_xor_si256(s0, s3);
+                        s2 = _mm256_xor_si256(s2, t);
+                        s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+                }
+                _mm256_storeu_si256((__m256i*)st, s0);
+                _mm256_storeu_si256((__m256i*)(st + 8), s1);
+                _mm256_storeu_si256((__m256i*)(st + 16), s2);
+                _mm256_storeu_si256((__m256i*)(st + 24), s3);
+#elif defined(QX_SIMD_SSE2) || defined(QX_SIMD_NEON)
+                // Two halves of four lanes, each writing every other group of four
+                for (size_t h = 0; h < QX_XOSHIRO_LANES; h += 4) {
+                        uint32_t* st = eng->state + h;
+                        size_t j = start;
+#if defined(QX_SIMD_SSE2)
+                        __m128i s0 = _mm_loadu_si128((const __m128i*)st);
+                        __m128i s1 = _mm_loadu_si128((const __m128i*)(st + 8));
+                        __m128i s2 = _mm_loadu_si128((const __m128i*)(st + 16));
+                        __m128i s3 = _mm_loadu_si128((const __m128i*)(st + 24));
+                        for (; j + 8 <= n; j += 8) {
+                                _mm_storeu_si128((__m128i*)(out + j + h), _mm_add_epi32(s0, s3));
+                                __m128i t = _mm_slli_epi32(s1, 9);
+                                s2 = _mm_xor_si128(s2, s0);
+                                s3 = _mm_xor_si128(s3, s1);
+                                s1 = _mm_xor_si128(s1, s2);
+                                s0 = _mm_xor_si128(s0, s3);
+                                s2 = _mm_xor_si128(s2, t);
+                                s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+                        }
+                        _mm_storeu_si128((__m128i*)st, s0);
+                        _mm_storeu_si128((__m128i*)(st + 8), s1);
+                        _mm_storeu_si128((__m128i*)(st + 16), s2);
+                        _mm_storeu_si128((__m128i*)(st + 24), s3);
+#else
+                        uint32x4_t s0 = vld1q_u32(st);
+                        uint32x4_t s1 = vld1q_u32(st + 8);
+                        uint32x4_t s2 = vld1q_u32(st + 16);
+                        uint32x4_t s3 = vld1q_u32(st + 24);
+                        for (; j + 8 <= n; j += 8) {
+                                vst1q_u32(out + j + h, vaddq_u32(s0, s3));
+                                uint32x4_t t = vshlq_n_u32(s1, 9);
+                                s2 = veorq_u32(s2, s0);
+                                s3 = veorq_u32(s3, s1);
+                                s1 = veorq_u32(s1, s2);
+                                s0 = veorq_u32(s0, s3);
+                                s2 = veorq_u32(s2, t);
+                                s3 = vsriq_n_u32(vshlq_n_u32(s3, 11), s3, 21);
+                        }
+                        vst1q_u32(st, s0);
+                        vst1q_u32(st + 8, s1);
+                        vst1q_u32(st + 16, s2);
+                        vst1q_u32(st + 24, s3);
+#endif
+                        i = j;
+                }
+#endif
+                eng->counter += i - start;
+                break;
+        }
+
+#if defined(QX_SIMD_AVX2)
+        case QX_RANDOM_ENGINE_PCG32:
+        {
+                if (n < 8)
+                        break;
+
+                uint64_t lanes[8];
+                uint64_t s = ((uint64_t)eng->state[1] << 32) | eng->state[0];
+                const uint64_t stream_inc = ((uint64_t)eng->state[3] << 32) | eng->state[2];
+                for (int k = 0; k < 8; k++) {
+                        lanes[k] = s;
+                        s = s * QX_PCG32_MUL + stream_inc;
+                }
+
+                uint64_t mul, inc;
+                qx_pcg32_jump(8, stream_inc, &mul, &inc);
+                const __m256i vmul = _mm256_set1_epi64x((long long)mul);
+                const __m256i vinc = _mm256_set1_epi64x((long long)inc);
+                const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+                __m256i x0 = _mm256_loadu_si256((const __m256i*)lanes);
+                __m256i x1 = _mm256_loadu_si256((const __m256i*)(lanes + 4));
+                for (; i + 8 <= n; i += 8) {
+                        __m256i r0 = _mm256_permutevar8x32_epi32(qx_pcg32_output_avx2(x0), pack);
+                        __m256i r1 = _mm256_permutevar8x32_epi32(qx_pcg32_output_avx2(x1), pack);
+                        _mm256_storeu_si256((__m256i*)(out + i),
+                                            _mm256_permute2x128_si256(r0, r1, 0x20));
+                        x0 = _mm256_add_epi64(qx_simd_mullo_epi64_avx2(x0, vmul), vinc);
+                        x1 = _mm256_add_epi64(qx_simd_mullo_epi64_avx2(x1, vmul), vinc);
+                }
+
+                uint64_t jmul, jinc;
+                qx_pcg32_jump(i, stream_inc, &jmul, &jinc);
+                s = ((uint64_t)eng->state[1] << 32) | eng->state[0];
+                s = s * jmul + jinc;
+                eng->state[0] = (uint32_t)s;
+                eng->state[1] = (uint32_t)(s >> 32);
+                eng->counter += i;
+                break;
+        }
+#endif
+
+#if defined(QX_RNG_VEC_LANES)
+        case QX_RANDOM_ENGINE_SPLITMIX:
+        {
+                const size_t lanes = QX_RNG_VEC_LANES;
+                const qx_rng_vec golden = qx_rng_set1(0x9e3779b9u);
+                while (i + lanes <= n) {
+                        uint64_t c = eng->counter;
+                        uint32_t lo = (uint32_t)c;
+                        if (lo > 0xffffffffu - (lanes - 1)) {
+                                // Counter high word changes inside this group
+                                for (size_t k = 0; k < lanes; k++)
+                                        out[i++] = qx_random_engine_next(eng);
+                                continue;
+                        }
+
+                        uint32_t base = eng->state[0] ^ qx_fmix32(eng->state[1] + (uint32_t)(c >> 32));
+                        uint64_t count = ((1ull << 32) - lo) / lanes;
+                        if (count > (n - i) / lanes)
+                                count = (n - i) / lanes;
+
+                        qx_rng_vec idx = qx_rng_iota(lo + 1u);
+                        const qx_rng_vec vstep = qx_rng_set1((uint32_t)lanes);
+                        const qx_rng_vec vbase = qx_rng_set1(base);
+                        for (uint64_t k = 0; k < count; k++) {
+                                qx_rng_vec z = qx_rng_add(vbase, qx_rng_mullo(idx, golden));
+                                qx_rng_store(out + i, qx_rng_fmix32(z));
+                                idx = qx_rng_add(idx, vstep);
+                                i += lanes;
+                        }
+                        eng->counter += count * lanes;
+                }
+                break;
+        }
+        case QX_RANDOM_ENGINE_PHILOX:
+        {
+                const size_t lanes = QX_RNG_VEC_LANES;
+                while (i < n && (eng->counter & 3) != 0)
+                        out[i++] = qx_random_engine_next(eng);
+
+                while (i + 4 * lanes <= n) {
+                        uint64_t block = eng->counter >> 2;
+                        uint32_t lo = (uint32_t)block;
+                        if ((uint32_t)(lo + lanes - 1) < lo) {
+                                for (size_t k = 0; k < 4 * lanes; k++)
+                                        out[i++] = qx_random_engine_next(eng);
+                                continue;
+                        }
+
+                        qx_rng_vec c0 = qx_rng_iota(lo);
+                        qx_rng_vec c1 = qx_rng_set1((uint32_t)(block >> 32));
+                        qx_rng_vec c2 = qx_rng_set1(0u);
+                        qx_rng_vec c3 = qx_rng_set1(0u);
+                        uint32_t k0 = eng->state[0];
+                        uint32_t k1 = eng->state[1];
+                        for (int r = 0; r < 10; r++) {
+                                qx_rng_vec hi0, lo0, hi1, lo1;
+                                qx_rng_mulhilo(c0, QX_PHILOX_M0, &hi0, &lo0);
+                                qx_rng_mulhilo(c2, QX_PHILOX_M1, &hi1, &lo1);
+                                c0 = qx_rng_xor(qx_rng_xor(hi1, c1), qx_rng_set1(k0));
+                                c2 = qx_rng_xor(qx_rng_xor(hi0, c3), qx_rng_set1(k1));
+                                c1 = lo1;
+                                c3 = lo0;
+                                k0 += QX_PHILOX_W0;
+                                k1 += QX_PHILOX_W1;
+                        }
+
+                        qx_rng_store_blocks(out + i, c0, c1, c2, c3);
+                        i += 4 * lanes;
+                        eng->counter += 4 * lanes;
+                }
+                break;
+        }
+#endif
+        default:
+                break;
+        }
+
+        for (; i < n; i++)
+                out[i] = qx_random_engine_next(eng);
+}
+
+/**
+ * @brief Sets the key of a counter-based engine and rewinds it.
+ *
+ * @param eng Pointer to an engine of type QX_RANDOM_ENGINE_SPLITMIX
+ *            or QX_RANDOM_ENGINE_PHILOX.
+ * @param key 64-bit key.
+ *
+ * After this call the engine produces qx_random_at(key, 0),
+ * qx_random_at(key, 1), ... for the Philox engine.
+ */
+static inline void qx_random_engine_set_key(struct qx_random_engine* eng, uint64_t key)
+{
+        eng->state[0] = (uint32_t)key;
+        eng->state[1] = (uint32_t)(key >> 32);
+        eng->counter = 0;
+}
+
+/**
+ * @brief Moves an engine to an absolute position in its sequence.
+ *
+ * @param eng Pointer to a seeded engine.
+ * @param counter Index of the next value to generate.
+ * @return false if the engine does not support seeking (xoshiro128+).
+ *
+ * O(1) for the counter-based engines and O(log n) jump-ahead
+ * (or jump-back through the period) for the LCG and PCG32 engines.
+ * To move a qx_randomizer use qx_randomizer_seek(), which also handles
+ * the default LCG randomizer whose state is not in an engine.
+ */
+static inline bool qx_random_engine_seek(struct qx_random_engine* eng, uint64_t counter)
+{
+        uint64_t steps = counter - eng->counter;
+
+        switch (eng->type) {
+        case QX_RANDOM_ENGINE_SPLITMIX:
+        case QX_RANDOM_ENGINE_PHILOX:
+                break;
+        case QX_RANDOM_ENGINE_PCG32:
+        {
+                uint64_t mul, inc;
+                qx_pcg32_jump(steps, ((uint64_t)eng->state[3] << 32) | eng->state[2], &mul, &inc);
+                uint64_t s = ((uint64_t)eng->state[1] << 32) | eng->state[0];
+                s = s * mul + inc;
+                eng->state[0] = (uint32_t)s;
+                eng->state[1] = (uint32_t)(s >> 32);
+                break;
+        }
+        case QX_RANDOM_ENGINE_LCG:
+        {
+                // The period 2^32 divides 2^64, so wrapped steps also jump back
+                uint32_t mul, inc;
+                qx_lcg_jump(steps, &mul, &inc);
+                eng->state[0] = eng->state[0] * mul + inc;
+                break;
+        }
+        default:
+                return false;
+        }
+
+        eng->counter = counter;
+        return true;
+}
+
+/**
+ * @brief Stateless counter-based random value.
+ *
+ * @param key 64-bit key (stream identifier / seed).
+ * @param counter Sample index.
+ * @return 32-bit random value, a pure function of key and counter.
+ *
+ * Any sample index can be computed directly, so a render can be split
+ * across threads or started at any position and stay reproducible.
+ * Based on Philox4x32-10: four consecutive counters share one block.
+ */
+static inline uint32_t qx_random_at(uint64_t key, uint64_t counter)
+{
+        uint32_t block[4];
+        qx_philox4x32((uint32_t)key, (uint32_t)(key >> 32), counter >> 2, block);
+        return block[counter & 3];
+}
+
+/**
+ * @brief Stateless counter-based bulk generation.
+ *
+ * @param key 64-bit key.
+ * @param counter Index of the first value.
+ * @param out Output buffer.
+ * @param n Number of values.
+ *
+ * out[i] = qx_random_at(key, counter + i), vectorized.
+ */
+static inline void qx_random_fill_at(uint64_t key, uint64_t counter, uint32_t* out, size_t n)
+{
+        struct qx_random_engine eng;
+        eng.type = QX_RANDOM_ENGINE_PHILOX;
+        qx_random_engine_set_key(&eng, key);
+        eng.counter = counter;
+        qx_random_engine_fill_u32(&eng, out, n);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_RANDOM_ENGINE_H
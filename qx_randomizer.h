@@ -27,9 +27,17 @@
 #ifndef QX_RANDOMIZER_H
 #define QX_RANDOMIZER_H
 
+#include "qx_simd.h"
+#include "qx_random_engine.h"
+#if defined(QX_DSP_LIBRARY)
+#include "qx_dsp.h"
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdatomic.h>
+#include <time.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +52,11 @@ extern "C" {
 *   prioritizing speed and repeatability over cryptographic-grade randomness.
 * - Given the same seed, the generated pattern is reproducible.
 * - No global state; multiple instances can coexist without interference.
+* - The generator engine can be selected per instance with
+*   qx_randomizer_init_engine(); the default is the 32-bit LCG.
+*   The LCG keeps its whole state in `seed`, so a default randomizer
+*   stays small; the state of the other engines lives in a separate
+*   struct qx_random_engine owned by the caller.
 *
 * @note Not thread-safe.
 */
@@ -58,55 +71,335 @@ struct qx_randomizer {
     float range;           /**< Cached: max - min. */
     float inv_max_uint;    /**< Cached: 1.0f / UINT32_MAX, for normalization. */
     int max_steps;         /**< Cached: number of quantization steps. */
+
+    struct qx_random_engine* engine; /**< Engine state owned by the caller, NULL for the default LCG. */
 };
 
+/*
+ * Process-wide seed source.
+ *
+ * Every randomizer gets a unique seed from one counter shared by the whole
+ * process. Programs linking the compiled library (QX_DSP_LIBRARY is then
+ * defined, e.g. by the CMake target or the pkg-config file) use the
+ * counter defined and exported once by the library, src/qx_seed.c, so
+ * the library and every module including this header share it.
+ *
+ * Without the library the header defines the counter itself as a weak
+ * symbol (selectany on MSVC), so the copies emitted by the translation
+ * units of one executable or shared object are merged by the linker.
+ * That only covers a single module: separate shared libraries or DLLs
+ * that each include the header get their own counter and may hand out
+ * the same seeds; link them against the compiled library instead.
+ *
+ * Each thread reserves a block of QX_SEED_BLOCK indices with one atomic
+ * fetch_add and hands them out without further atomic read-modify-writes.
+ * Blocks never overlap, so the seeds are unique across threads; the index
+ * is mapped through a bijection, so up to 2^32 seeds are all distinct.
+ */
+#if defined(_MSC_VER)
+#define QX_SEED_SHARED __declspec(selectany)
+#define QX_THREAD_LOCAL __declspec(thread)
+#else
+#define QX_SEED_SHARED __attribute__((weak))
+#define QX_THREAD_LOCAL _Thread_local
+#endif
+
+/** Number of seeds a thread reserves at once. */
+#define QX_SEED_BLOCK 256u
+
+#if defined(QX_DSP_LIBRARY)
+/** Next free seed index of the process. */
+extern QX_DSP_API atomic_uint qx_seed_counter;
+
+/** Value mixed into every seed, 0 unless set with qx_seed_set_entropy(). */
+extern QX_DSP_API atomic_uint qx_seed_entropy;
+#else
+/** Next free seed index of the process. */
+QX_SEED_SHARED atomic_uint qx_seed_counter = 0u;
+
+/** Value mixed into every seed, 0 unless set with qx_seed_set_entropy(). */
+QX_SEED_SHARED atomic_uint qx_seed_entropy = 0u;
+#endif
+
+/**
+ * @brief A range of reserved seed indices, [next, end).
+ *
+ * Zero-initialize before the first use. Each thread has one internally
+ * (see qx_seed_thread_stream()); a voice allocator can also keep its own.
+ */
+struct qx_seed_stream {
+        uint32_t next;
+        uint32_t end;
+};
+
+/**
+ * @brief Mix a value into all the seeds generated from now on.
+ *
+ * Call once at startup, before creating randomizers, to get different
+ * seeds on every run. Seeds generated before and after a change of the
+ * entropy are not guaranteed to be distinct.
+ *
+ * @param entropy Any value, e.g. from qx_seed_startup_entropy().
+ */
+static inline void qx_seed_set_entropy(uint32_t entropy)
+{
+        atomic_store_explicit(&qx_seed_entropy, entropy, memory_order_relaxed);
+}
+
+/**
+ * @brief Gather a startup entropy value.
+ *
+ * Mixes the wall clock in nanoseconds with stack and code addresses,
+ * which differ between runs with address space layout randomization.
+ * Not suitable for cryptographic purposes.
+ *
+ * @return 32-bit entropy value.
+ */
+static inline uint32_t qx_seed_startup_entropy(void)
+{
+        struct timespec ts = {0, 0};
+        timespec_get(&ts, TIME_UTC);
+        int local = 0;
+        uint64_t h = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+        h ^= (uint64_t)(uintptr_t)&local * 0x9e3779b97f4a7c15u;
+        h ^= (uint64_t)(uintptr_t)&qx_seed_counter >> 4;
+        return qx_fmix32((uint32_t)h ^ qx_fmix32((uint32_t)(h >> 32)));
+}
+
+/**
+ * @brief Reserve a range of seed indices from the process-wide counter.
+ *
+ * One atomic operation, whatever the count.
+ *
+ * @param count Number of indices.
+ * @return First index of the range, pass the indices to qx_seed_at().
+ */
+static inline uint32_t qx_seed_reserve(uint32_t count)
+{
+        return atomic_fetch_add_explicit(&qx_seed_counter, count, memory_order_relaxed);
+}
+
+/**
+ * @brief Map a reserved seed index to its seed.
+ *
+ * @param index Index obtained from qx_seed_reserve() or qx_seed_stream_take().
+ * @return A 32-bit seed; distinct indices give distinct seeds.
+ */
+static inline uint32_t qx_seed_at(uint32_t index)
+{
+        uint32_t entropy = atomic_load_explicit(&qx_seed_entropy, memory_order_relaxed);
+        return qx_fmix32(entropy + 1u + index * 0x9e3779b9u);
+}
+
+/**
+ * @brief Take consecutive seed indices from a stream.
+ *
+ * Only touches the process-wide counter when the stream has fewer than
+ * @p count indices left; it then reserves at least QX_SEED_BLOCK.
+ *
+ * @param stream Seed stream, used by one thread at a time.
+ * @param count Number of indices.
+ * @return First index of the range, pass the indices to qx_seed_at().
+ */
+static inline uint32_t qx_seed_stream_take(struct qx_seed_stream* stream, uint32_t count)
+{
+        if (stream->end - stream->next < count) {
+                uint32_t reserve = count > QX_SEED_BLOCK ? count : QX_SEED_BLOCK;
+                stream->next = qx_seed_reserve(reserve);
+                stream->end = stream->next + reserve;
+        }
+
+        uint32_t first = stream->next;
+        stream->next += count;
+        return first;
+}
+
+/**
+ * @brief Get the seed stream of the calling thread.
+ *
+ * @return Pointer to a thread-local stream.
+ */
+static inline struct qx_seed_stream* qx_seed_thread_stream(void)
+{
+        static QX_THREAD_LOCAL struct qx_seed_stream stream;
+        return &stream;
+}
+
 /**
- * @brief Global atomic seed used for generating unique seeds via SplitMix32.
+ * @brief Take the next unique seed from the process-wide seed source.
  *
- * Atomic ensures thread-safe updates without locking,
- * suitable for real-time audio.
+ * Uses the seed stream of the calling thread, so there is one atomic
+ * operation per QX_SEED_BLOCK seeds.
+ *
+ * @return A 32-bit seed, distinct from all the others of the process.
  */
-static atomic_uint qx_global_seed = 1u;
+static inline uint32_t qx_seed_next(void)
+{
+        return qx_seed_at(qx_seed_stream_take(qx_seed_thread_stream(), 1));
+}
 
 /**
  * @brief SplitMix32 generator for producing high-quality 32-bit seeds.
  *
- * Each call advances the internal global seed and returns a new pseudo-random value.
+ * Returns the next seed of the process-wide seed source, see qx_seed_next().
  * This is used only to initialize qx_randomizer instances with unique seeds.
  *
  * @return A 32-bit pseudo-random seed value.
  */
 static inline uint32_t qx_splitmix32()
 {
-        uint32_t z = atomic_fetch_add(&qx_global_seed, 0x9e3779b9u);
-        z = (z ^ (z >> 16)) * 0x85ebca6bu;
-        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
-        return z ^ (z >> 16);
+        return qx_seed_next();
 }
 
 /**
- * @brief Initializes a `qx_randomizer` instance.
+ * @brief Initializes a `qx_randomizer` instance from a given seed.
  *
  * @param rand Pointer to the randomizer structure to initialize.
- * @param seed Initial seed for the pseudo-random generator.
+ * @param engine Engine state for @p type, owned by the caller and used by
+ *               this randomizer only. Ignored for QX_RANDOM_ENGINE_LCG;
+ *               NULL also selects the LCG.
+ * @param type Generator engine.
+ * @param seed Seed from the seed source, see qx_seed_at().
  * @param min Minimum float value that can be generated (inclusive).
  * @param max Maximum float value that can be generated (inclusive).
  * @param resolution Step size for quantized output values.
  *
- * This function precomputes internal values for fast usage in loops.
+ * Used by the other init functions; call it directly to reproduce a
+ * randomizer from a known seed.
  */
-static inline void qx_randomizer_init(struct qx_randomizer* rand,
-                                      float min,
-                                      float max,
-                                      float resolution)
+static inline void qx_randomizer_init_seed(struct qx_randomizer* rand,
+                                           struct qx_random_engine* engine,
+                                           enum qx_random_engine_type type,
+                                           uint32_t seed,
+                                           float min,
+                                           float max,
+                                           float resolution)
 {
-        rand->seed = 856382025u + qx_splitmix32();
+        rand->seed = 856382025u + seed;
         rand->min = min;
         rand->max = max;
         rand->resolution = resolution;
         rand->range = max - min;
         rand->inv_max_uint = 1.0f / (float)UINT32_MAX;
         rand->max_steps = (int)(rand->range / resolution + 0.5f);
+        rand->engine = NULL;
+        if (engine && type != QX_RANDOM_ENGINE_LCG) {
+                qx_random_engine_seed(engine, type, rand->seed);
+                rand->engine = engine;
+        }
+}
+
+/**
+ * @brief Initializes a `qx_randomizer` instance.
+ *
+ * @param rand Pointer to the randomizer structure to initialize.
+ * @param min Minimum float value that can be generated (inclusive).
+ * @param max Maximum float value that can be generated (inclusive).
+ * @param resolution Step size for quantized output values.
+ *
+ * This function precomputes internal values for fast usage in loops.
+ */
+static inline void qx_randomizer_init(struct qx_randomizer* rand,
+                                      float min,
+                                      float max,
+                                      float resolution)
+{
+        qx_randomizer_init_seed(rand, NULL, QX_RANDOM_ENGINE_LCG, qx_splitmix32(), min, max, resolution);
+}
+
+/**
+ * @brief Initializes a `qx_randomizer` instance with a specific generator engine.
+ *
+ * @param rand Pointer to the randomizer structure to initialize.
+ * @param engine Engine state, see qx_randomizer_init_seed().
+ * @param type Generator engine.
+ * @param min Minimum float value that can be generated (inclusive).
+ * @param max Maximum float value that can be generated (inclusive).
+ * @param resolution Step size for quantized output values.
+ *
+ * Same as qx_randomizer_init(), with the engine state seeded from the
+ * unique seed assigned to the instance. The engine state must outlive
+ * the randomizer; a copy of the randomizer shares it.
+ */
+static inline void qx_randomizer_init_engine(struct qx_randomizer* rand,
+                                             struct qx_random_engine* engine,
+                                             enum qx_random_engine_type type,
+                                             float min,
+                                             float max,
+                                             float resolution)
+{
+        qx_randomizer_init_seed(rand, engine, type, qx_splitmix32(), min, max, resolution);
+}
+
+/**
+ * @brief Initialize an array of randomizers with one seed reservation.
+ *
+ * Same seeds as calling qx_randomizer_init_engine() for every element
+ * from the same counter position with an empty thread stream, but the
+ * n seeds are reserved from the process-wide counter with a single
+ * atomic operation and derived locally, e.g. when a chord allocates many
+ * voices at once. More than UINT32_MAX randomizers take one reservation
+ * per UINT32_MAX.
+ *
+ * @param rands Array of randomizers to initialize.
+ * @param engines Array of n engine states, or NULL for the LCG.
+ * @param n Number of randomizers.
+ * @param type Generator engine.
+ * @param min Minimum float value that can be generated (inclusive).
+ * @param max Maximum float value that can be generated (inclusive).
+ * @param resolution Step size for quantized output values.
+ */
+static inline void qx_randomizer_init_batch(struct qx_randomizer* rands,
+                                            struct qx_random_engine* engines,
+                                            size_t n,
+                                            enum qx_random_engine_type type,
+                                            float min,
+                                            float max,
+                                            float resolution)
+{
+        for (size_t pos = 0; pos < n; pos += UINT32_MAX) {
+                uint32_t count = n - pos < UINT32_MAX ? (uint32_t)(n - pos) : UINT32_MAX;
+                uint32_t first = qx_seed_reserve(count);
+                for (uint32_t i = 0; i < count; i++)
+                        qx_randomizer_init_seed(&rands[pos + i], engines ? &engines[pos + i] : NULL, type,
+                                                qx_seed_at(first + i), min, max, resolution);
+        }
+}
+
+/**
+ * @brief Initialize an array of randomizers from a seed stream.
+ *
+ * Like qx_randomizer_init_batch(), but the seeds come from @p stream, which
+ * only touches the process-wide counter when it runs out. Pass NULL to use
+ * the seed stream of the calling thread.
+ *
+ * @param stream Seed stream, or NULL for the thread-local one.
+ * @param rands Array of randomizers to initialize.
+ * @param engines Array of n engine states, or NULL for the LCG.
+ * @param n Number of randomizers.
+ * @param type Generator engine.
+ * @param min Minimum float value that can be generated (inclusive).
+ * @param max Maximum float value that can be generated (inclusive).
+ * @param resolution Step size for quantized output values.
+ */
+static inline void qx_randomizer_init_stream(struct qx_seed_stream* stream,
+                                             struct qx_randomizer* rands,
+                                             struct qx_random_engine* engines,
+                                             size_t n,
+                                             enum qx_random_engine_type type,
+                                             float min,
+                                             float max,
+                                             float resolution)
+{
+        if (!stream)
+                stream = qx_seed_thread_stream();
+        for (size_t pos = 0; pos < n; pos += UINT32_MAX) {
+                uint32_t count = n - pos < UINT32_MAX ? (uint32_t)(n - pos) : UINT32_MAX;
+                uint32_t first = qx_seed_stream_take(stream, count);
+                for (uint32_t i = 0; i < count; i++)
+                        qx_randomizer_init_seed(&rands[pos + i], engines ? &engines[pos + i] : NULL, type,
+                                                qx_seed_at(first + i), min, max, resolution);
+        }
 }
 
 /**
@@ -121,6 +414,8 @@ static inline void qx_randomizer_init(struct qx_randomizer* rand,
 static inline void qx_randomizer_set_seed(struct qx_randomizer* rand, uint32_t seed)
 {
     rand->seed = seed;
+    if (rand->engine)
+        qx_random_engine_seed(rand->engine, rand->engine->type, seed);
 }
 
 /**
@@ -160,6 +455,60 @@ static inline void qx_randomizer_set_resolution(struct qx_randomizer* rand, floa
     rand->max_steps = (int)(rand->range / resolution + 0.5f);
 }
 
+/**
+ * @brief Advances the LCG state of the randomizer as if `steps` values were generated.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer` using the LCG engine.
+ * @param steps Number of values to skip.
+ */
+static inline void qx_randomizer_skip(struct qx_randomizer* rand, uint64_t steps)
+{
+        uint32_t mul, inc;
+        qx_lcg_jump(steps, &mul, &inc);
+        rand->seed = rand->seed * mul + inc;
+}
+
+/**
+ * @brief Moves the randomizer forward or back in its sequence.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param offset Number of values to skip, negative to go back.
+ * @return false, leaving the state unchanged, if the engine does not
+ *         support seeking (xoshiro128+).
+ *
+ * Updates the state the generator actually reads: `seed` for the LCG,
+ * the engine state otherwise (see qx_random_engine_seek()).
+ */
+static inline bool qx_randomizer_seek(struct qx_randomizer* rand, int64_t offset)
+{
+        if (rand->engine)
+                return qx_random_engine_seek(rand->engine, rand->engine->counter + (uint64_t)offset);
+
+        // The period 2^32 divides 2^64, so a wrapped offset jumps back
+        qx_randomizer_skip(rand, (uint64_t)offset);
+        return true;
+}
+
+/**
+ * @brief Maps a raw generator state to a quantized float within the configured range.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param seed Generator state.
+ * @return A float value in [min, max].
+ */
+static inline float qx_randomizer_map(const struct qx_randomizer* rand, uint32_t seed)
+{
+    float normalized = seed * rand->inv_max_uint;
+    int step = (int)(normalized * (rand->max_steps + 1));
+
+    if (step > rand->max_steps)
+            step = rand->max_steps;
+
+    // A fused multiply-add can round the last step above max
+    float value = rand->min + step * rand->resolution;
+    return value > rand->max ? rand->max : value;
+}
+
 /**
  * @brief Generates a random quantized float within the configured range.
  *
@@ -171,15 +520,282 @@ static inline void qx_randomizer_set_resolution(struct qx_randomizer* rand, floa
  */
 static inline float qx_randomizer_get_float(struct qx_randomizer* rand)
 {
-    rand->seed = rand->seed * 1664525u + 1013904223u;
+    if (rand->engine)
+        return qx_randomizer_map(rand, qx_random_engine_next(rand->engine));
 
-    float normalized = rand->seed * rand->inv_max_uint;
-    int step = (int)(normalized * (rand->max_steps + 1));
+    rand->seed = rand->seed * QX_LCG_MUL + QX_LCG_INC;
+    return qx_randomizer_map(rand, rand->seed);
+}
 
-    if (step > rand->max_steps)
-            step = rand->max_steps;
+/**
+ * @brief Generates the next raw 32-bit value of the randomizer.
+ *
+ * Advances the generator exactly like qx_randomizer_get_float(). With the
+ * LCG engine the low bits are weak; use the high bits first.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @return Raw generator output.
+ */
+static inline uint32_t qx_randomizer_next_u32(struct qx_randomizer* rand)
+{
+        if (rand->engine)
+                return qx_random_engine_next(rand->engine);
+
+        rand->seed = rand->seed * QX_LCG_MUL + QX_LCG_INC;
+        return rand->seed;
+}
+
+/**
+ * @brief Fills a buffer with raw 32-bit values of the randomizer.
+ *
+ * Same values and final state as calling qx_randomizer_next_u32() `n`
+ * times. The LCG runs as four interleaved streams advanced with
+ * jump-ahead constants, which the compiler vectorizes.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_randomizer_fill_u32(struct qx_randomizer* rand, uint32_t* out, size_t n)
+{
+        if (rand->engine) {
+                qx_random_engine_fill_u32(rand->engine, out, n);
+                return;
+        }
+
+        size_t i = 0;
+        if (n >= 4) {
+                uint32_t s[4];
+                uint32_t seed = rand->seed;
+                for (size_t k = 0; k < 4; k++) {
+                        seed = seed * QX_LCG_MUL + QX_LCG_INC;
+                        s[k] = seed;
+                }
+
+                uint32_t mul, inc;
+                qx_lcg_jump(4, &mul, &inc);
+                for (; i + 4 <= n; i += 4) {
+                        for (size_t k = 0; k < 4; k++) {
+                                out[i + k] = s[k];
+                                s[k] = s[k] * mul + inc;
+                        }
+                }
+                rand->seed = out[i - 1];
+        }
+        for (; i < n; i++)
+                out[i] = qx_randomizer_next_u32(rand);
+}
 
-    return rand->min + step * rand->resolution;
+/*
+ * SIMD versions of qx_randomizer_map(). Every step is done in the same
+ * order and precision as the scalar code, so the results are bit-identical.
+ */
+#if defined(QX_SIMD_AVX2)
+static inline __m256 qx_randomizer_map_avx2(const struct qx_randomizer* rand, __m256i seed)
+{
+        __m256 normalized = _mm256_mul_ps(qx_simd_cvtepu32_ps_avx2(seed),
+                                          _mm256_set1_ps(rand->inv_max_uint));
+        __m256i step = _mm256_cvttps_epi32(_mm256_mul_ps(normalized,
+                                                         _mm256_set1_ps((float)(rand->max_steps + 1))));
+        step = _mm256_min_epi32(step, _mm256_set1_epi32(rand->max_steps));
+        __m256 value = _mm256_add_ps(_mm256_set1_ps(rand->min),
+                                     _mm256_mul_ps(_mm256_cvtepi32_ps(step),
+                                                   _mm256_set1_ps(rand->resolution)));
+        return _mm256_min_ps(value, _mm256_set1_ps(rand->max));
+}
+#elif defined(QX_SIMD_SSE2)
+static inline __m128 qx_randomizer_map_sse2(const struct qx_randomizer* rand, __m128i seed)
+{
+        __m128 normalized = _mm_mul_ps(qx_simd_cvtepu32_ps(seed),
+                                       _mm_set1_ps(rand->inv_max_uint));
+        __m128i step = _mm_cvttps_epi32(_mm_mul_ps(normalized,
+                                                   _mm_set1_ps((float)(rand->max_steps + 1))));
+        __m128i max_steps = _mm_set1_epi32(rand->max_steps);
+        __m128i over = _mm_cmpgt_epi32(step, max_steps);
+        step = _mm_or_si128(_mm_and_si128(over, max_steps), _mm_andnot_si128(over, step));
+        __m128 value = _mm_add_ps(_mm_set1_ps(rand->min),
+                                  _mm_mul_ps(_mm_cvtepi32_ps(step), _mm_set1_ps(rand->resolution)));
+        return _mm_min_ps(value, _mm_set1_ps(rand->max));
+}
+#elif defined(QX_SIMD_NEON)
+static inline float32x4_t qx_randomizer_map_neon(const struct qx_randomizer* rand, uint32x4_t seed)
+{
+        float32x4_t normalized = vmulq_n_f32(vcvtq_f32_u32(seed), rand->inv_max_uint);
+        int32x4_t step = vcvtq_s32_f32(vmulq_n_f32(normalized, (float)(rand->max_steps + 1)));
+        step = vminq_s32(step, vdupq_n_s32(rand->max_steps));
+        float32x4_t value = vaddq_f32(vdupq_n_f32(rand->min),
+                                      vmulq_n_f32(vcvtq_f32_s32(step), rand->resolution));
+        return vminq_f32(value, vdupq_n_f32(rand->max));
+}
+#endif
+
+/**
+ * @brief Number of values generated per chunk by the engine bulk fill.
+ */
+#define QX_RANDOMIZER_CHUNK 256
+
+/**
+ * @brief Maps an array of raw generator values to quantized floats.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param in Raw 32-bit values.
+ * @param out Output buffer.
+ * @param n Number of values.
+ */
+static inline void qx_randomizer_map_array(const struct qx_randomizer* rand,
+                                           const uint32_t* in,
+                                           float* out,
+                                           size_t n)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX2)
+        for (; i + 8 <= n; i += 8)
+                _mm256_storeu_ps(out + i, qx_randomizer_map_avx2(rand,
+                                 _mm256_loadu_si256((const __m256i*)(in + i))));
+#elif defined(QX_SIMD_SSE2)
+        for (; i + 4 <= n; i += 4)
+                _mm_storeu_ps(out + i, qx_randomizer_map_sse2(rand,
+                              _mm_loadu_si128((const __m128i*)(in + i))));
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4)
+                vst1q_f32(out + i, qx_randomizer_map_neon(rand, vld1q_u32(in + i)));
+#endif
+        for (; i < n; i++)
+                out[i] = qx_randomizer_map(rand, in[i]);
+}
+
+/**
+ * @brief Fills a buffer with random quantized floats.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`.
+ * @param out Output buffer.
+ * @param n Number of values to generate.
+ *
+ * Produces exactly the same values, and leaves the randomizer in the same
+ * state, as calling qx_randomizer_get_float() `n` times. Non-LCG engines
+ * use qx_random_engine_fill_u32() in chunks. The LCG is split
+ * into 16 (AVX2) or 8 (SSE2/NEON) interleaved streams, each one advanced
+ * with jump-ahead constants, so the lanes do not depend on each other.
+ */
+static inline void qx_randomizer_fill(struct qx_randomizer* rand, float* out, size_t n)
+{
+        if (rand->engine) {
+                uint32_t raw[QX_RANDOMIZER_CHUNK];
+                for (size_t pos = 0; pos < n; pos += QX_RANDOMIZER_CHUNK) {
+                        size_t count = n - pos;
+                        if (count > QX_RANDOMIZER_CHUNK)
+                                count = QX_RANDOMIZER_CHUNK;
+                        qx_random_engine_fill_u32(rand->engine, raw, count);
+                        qx_randomizer_map_array(rand, raw, out + pos, count);
+                }
+                return;
+        }
+
+        size_t i = 0;
+#if defined(QX_SIMD_AVX2) || defined(QX_SIMD_SSE2) || defined(QX_SIMD_NEON)
+#if defined(QX_SIMD_AVX2)
+        enum { lanes = 16 };
+#else
+        enum { lanes = 8 };
+#endif
+        if (n >= lanes) {
+                uint32_t seeds[lanes];
+                uint32_t seed = rand->seed;
+                for (size_t k = 0; k < lanes; k++) {
+                        seed = seed * QX_LCG_MUL + QX_LCG_INC;
+                        seeds[k] = seed;
+                }
+
+                uint32_t mul, inc;
+                qx_lcg_jump(lanes, &mul, &inc);
+#if defined(QX_SIMD_AVX2)
+                const __m256i vmul = _mm256_set1_epi32((int)mul);
+                const __m256i vinc = _mm256_set1_epi32((int)inc);
+                __m256i x0 = _mm256_loadu_si256((const __m256i*)seeds);
+                __m256i x1 = _mm256_loadu_si256((const __m256i*)(seeds + 8));
+                for (; i + lanes <= n; i += lanes) {
+                        _mm256_storeu_ps(out + i, qx_randomizer_map_avx2(rand, x0));
+                        _mm256_storeu_ps(out + i + 8, qx_randomizer_map_avx2(rand, x1));
+                        x0 = _mm256_add_epi32(_mm256_mullo_epi32(x0, vmul), vinc);
+                        x1 = _mm256_add_epi32(_mm256_mullo_epi32(x1, vmul), vinc);
+                }
+#elif defined(QX_SIMD_SSE2)
+                const __m128i vmul = _mm_set1_epi32((int)mul);
+                const __m128i vinc = _mm_set1_epi32((int)inc);
+                __m128i x0 = _mm_loadu_si128((const __m128i*)seeds);
+                __m128i x1 = _mm_loadu_si128((const __m128i*)(seeds + 4));
+                for (; i + lanes <= n; i += lanes) {
+                        _mm_storeu_ps(out + i, qx_randomizer_map_sse2(rand, x0));
+                        _mm_storeu_ps(out + i + 4, qx_randomizer_map_sse2(rand, x1));
+                        x0 = _mm_add_epi32(qx_simd_mullo_epi32(x0, vmul), vinc);
+                        x1 = _mm_add_epi32(qx_simd_mullo_epi32(x1, vmul), vinc);
+                }
+#else
+                const uint32x4_t vinc = vdupq_n_u32(inc);
+                uint32x4_t x0 = vld1q_u32(seeds);
+                uint32x4_t x1 = vld1q_u32(seeds + 4);
+                for (; i + lanes <= n; i += lanes) {
+                        vst1q_f32(out + i, qx_randomizer_map_neon(rand, x0));
+                        vst1q_f32(out + i + 4, qx_randomizer_map_neon(rand, x1));
+                        x0 = vmlaq_n_u32(vinc, x0, mul);
+                        x1 = vmlaq_n_u32(vinc, x1, mul);
+                }
+#endif
+                qx_randomizer_skip(rand, i);
+        }
+#endif
+        out += i;
+        for (n -= i; n > 0; n--) {
+                rand->seed = rand->seed * QX_LCG_MUL + QX_LCG_INC;
+                *out++ = qx_randomizer_map(rand, rand->seed);
+        }
+}
+
+/**
+ * @brief Stateless counter-based quantized float.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer`; only the output
+ *             range and resolution are used, the generator state is not touched.
+ * @param key 64-bit key.
+ * @param counter Sample index.
+ * @return A float value in [min, max], a pure function of key and counter.
+ *
+ * See qx_random_at(). A randomizer using QX_RANDOM_ENGINE_PHILOX whose engine
+ * key was set with qx_random_engine_set_key() produces the same sequence.
+ */
+static inline float qx_randomizer_get_float_at(const struct qx_randomizer* rand,
+                                               uint64_t key,
+                                               uint64_t counter)
+{
+        return qx_randomizer_map(rand, qx_random_at(key, counter));
+}
+
+/**
+ * @brief Stateless counter-based bulk generation of quantized floats.
+ *
+ * @param rand Pointer to an initialized `qx_randomizer` (range and resolution only).
+ * @param key 64-bit key.
+ * @param counter Index of the first value.
+ * @param out Output buffer.
+ * @param n Number of values.
+ *
+ * out[i] = qx_randomizer_get_float_at(rand, key, counter + i). Different
+ * threads can fill different parts of a buffer independently.
+ */
+static inline void qx_randomizer_fill_at(const struct qx_randomizer* rand,
+                                         uint64_t key,
+                                         uint64_t counter,
+                                         float* out,
+                                         size_t n)
+{
+        uint32_t raw[QX_RANDOMIZER_CHUNK];
+        for (size_t pos = 0; pos < n; pos += QX_RANDOMIZER_CHUNK) {
+                size_t count = n - pos;
+                if (count > QX_RANDOMIZER_CHUNK)
+                        count = QX_RANDOMIZER_CHUNK;
+                qx_random_fill_at(key, counter + pos, raw, count);
+                qx_randomizer_map_array(rand, raw, out + pos, count);
+        }
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,622 @@
+/**
+ * @file qx_simd.h
+ * @brief SIMD helpers and block kernels shared by Quamplex DSP Tools.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_SIMD_H
+#define QX_SIMD_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The instruction set is selected at compile time from the compiler flags
+ * (-msse2, -mavx, -mavx2, -mavx512f, NEON on ARM). Define QX_NO_SIMD before including
+ * any qx_* header to force the portable scalar code paths.
+ */
+#if !defined(QX_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define QX_SIMD_SSE2 1
+#  endif
+#  if defined(__AVX__)
+#    define QX_SIMD_AVX 1
+#  endif
+#  if defined(__AVX2__)
+#    define QX_SIMD_AVX2 1
+#  endif
+#  if defined(__AVX512F__)
+#    define QX_SIMD_AVX512 1
+#  endif
+#  if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define QX_SIMD_NEON 1
+#  endif
+#endif
+
+#if defined(QX_SIMD_SSE2) || defined(QX_SIMD_AVX)
+#include <immintrin.h>
+#endif
+
+#if defined(QX_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Alignment in bytes of buffers allocated by qx_simd_aligned_alloc().
+ *
+ * Large enough for any supported vector width and a cache line.
+ */
+#define QX_SIMD_ALIGN 64
+
+/**
+ * @brief Allocate memory aligned to QX_SIMD_ALIGN bytes.
+ *
+ * @param size Size in bytes.
+ * @return Pointer to the memory, or NULL on failure.
+ *         Must be released with qx_simd_aligned_free().
+ */
+static inline void* qx_simd_aligned_alloc(size_t size)
+{
+        size = (size + QX_SIMD_ALIGN - 1) / QX_SIMD_ALIGN * QX_SIMD_ALIGN;
+        if (size == 0)
+                size = QX_SIMD_ALIGN;
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, QX_SIMD_ALIGN);
+#else
+        return aligned_alloc(QX_SIMD_ALIGN, size);
+#endif
+}
+
+/**
+ * @brief Release memory allocated with qx_simd_aligned_alloc().
+ *
+ * @param ptr Pointer to the memory (may be NULL).
+ */
+static inline void qx_simd_aligned_free(void* ptr)
+{
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+}
+
+#if defined(QX_SIMD_SSE2)
+/**
+ * @brief Multiply packed 32-bit integers, keeping the low 32 bits.
+ *
+ * Uses _mm_mullo_epi32 when SSE4.1 is available and emulates it
+ * with two _mm_mul_epu32 otherwise.
+ */
+static inline __m128i qx_simd_mullo_epi32(__m128i a, __m128i b)
+{
+#if defined(__SSE4_1__)
+        return _mm_mullo_epi32(a, b);
+#else
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+/**
+ * @brief Convert packed unsigned 32-bit integers to float.
+ *
+ * Rounds exactly like a scalar (float) conversion of a uint32_t.
+ */
+static inline __m128 qx_simd_cvtepu32_ps(__m128i x)
+{
+        __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(x, 16));
+        __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(x, _mm_set1_epi32(0xffff)));
+        return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo);
+}
+
+/**
+ * @brief Round packed floats toward negative infinity.
+ *
+ * Uses _mm_floor_ps when SSE4.1 is available. Otherwise truncates through
+ * int32, values of magnitude 2^23 or more are already integral.
+ * Same result as floorf() for every input, including inf and NaN.
+ */
+static inline __m128 qx_simd_floor_ps(__m128 x)
+{
+#if defined(__SSE4_1__)
+        return _mm_round_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+#else
+        __m128 small = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x), _mm_set1_ps(8388608.0f));
+        __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+        // Keep the sign of -0.0 and negative values that truncate to 0
+        t = _mm_or_ps(t, _mm_and_ps(x, _mm_set1_ps(-0.0f)));
+        return _mm_or_ps(_mm_and_ps(small, t), _mm_andnot_ps(small, x));
+#endif
+}
+#endif
+
+#if defined(QX_SIMD_NEON)
+/**
+ * @brief Round packed floats toward negative infinity (NEON).
+ *
+ * Same result as floorf() for every input, including inf and NaN.
+ */
+static inline float32x4_t qx_simd_floor_neon(float32x4_t x)
+{
+#if defined(__aarch64__)
+        return vrndmq_f32(x);
+#else
+        uint32x4_t small = vcaltq_f32(x, vdupq_n_f32(8388608.0f));
+        float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(x));
+        t = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(t, x),
+                                                         vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+        t = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(t),
+                                            vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000u))));
+        return vbslq_f32(small, t, x);
+#endif
+}
+#endif
+
+#if defined(QX_SIMD_AVX2)
+/**
+ * @brief Convert packed unsigned 32-bit integers to float (AVX2).
+ */
+static inline __m256 qx_simd_cvtepu32_ps_avx2(__m256i x)
+{
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 16));
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(x, _mm256_set1_epi32(0xffff)));
+        return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo);
+}
+#endif
+
+/**
+ * @brief Fill a buffer with a clamped linear ramp.
+ *
+ * out[i] = clamp(start + delta * (i + 1), lo, hi)
+ *
+ * The ramp is computed from the sample index rather than accumulated,
+ * so there is no drift over long blocks.
+ *
+ * @param out Output buffer.
+ * @param n Number of samples.
+ * @param start Value before the first sample.
+ * @param delta Increment per sample.
+ * @param lo Lower clamp bound.
+ * @param hi Upper clamp bound.
+ */
+static inline void qx_simd_ramp_fill(float* out, size_t n,
+                                     float start, float delta,
+                                     float lo, float hi)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 offs = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f,
+                                                   5.0f, 6.0f, 7.0f, 8.0f);
+                const __m256 vstart = _mm256_set1_ps(start);
+                const __m256 vdelta = _mm256_set1_ps(delta);
+                const __m256 vlo = _mm256_set1_ps(lo);
+                const __m256 vhi = _mm256_set1_ps(hi);
+                for (; i + 8 <= n; i += 8) {
+                        __m256 idx = _mm256_add_ps(_mm256_set1_ps((float)i), offs);
+                        __m256 g = _mm256_add_ps(vstart, _mm256_mul_ps(vdelta, idx));
+                        g = _mm256_min_ps(_mm256_max_ps(g, vlo), vhi);
+                        _mm256_storeu_ps(out + i, g);
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 offs = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+                const __m128 vstart = _mm_set1_ps(start);
+                const __m128 vdelta = _mm_set1_ps(delta);
+                const __m128 vlo = _mm_set1_ps(lo);
+                const __m128 vhi = _mm_set1_ps(hi);
+                for (; i + 4 <= n; i += 4) {
+                        __m128 idx = _mm_add_ps(_mm_set1_ps((float)i), offs);
+                        __m128 g = _mm_add_ps(vstart, _mm_mul_ps(vdelta, idx));
+                        g = _mm_min_ps(_mm_max_ps(g, vlo), vhi);
+                        _mm_storeu_ps(out + i, g);
+                }
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                const float offs_init[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+                const float32x4_t offs = vld1q_f32(offs_init);
+                const float32x4_t vstart = vdupq_n_f32(start);
+                const float32x4_t vdelta = vdupq_n_f32(delta);
+                const float32x4_t vlo = vdupq_n_f32(lo);
+                const float32x4_t vhi = vdupq_n_f32(hi);
+                for (; i + 4 <= n; i += 4) {
+                        float32x4_t idx = vaddq_f32(vdupq_n_f32((float)i), offs);
+                        float32x4_t g = vaddq_f32(vstart, vmulq_f32(vdelta, idx));
+                        g = vminq_f32(vmaxq_f32(g, vlo), vhi);
+                        vst1q_f32(out + i, g);
+                }
+        }
+#endif
+        for (; i < n; i++) {
+                float g = start + delta * ((float)i + 1.0f);
+                out[i] = g < lo ? lo : (g > hi ? hi : g);
+        }
+}
+
+/**
+ * @brief Multiply a buffer by a clamped linear ramp.
+ *
+ * out[i] = in[i] * clamp(start + delta * (i + 1), lo, hi)
+ *
+ * @param in Input buffer.
+ * @param out Output buffer (may be the same as @p in).
+ * @param n Number of samples.
+ * @param start Value before the first sample.
+ * @param delta Increment per sample.
+ * @param lo Lower clamp bound.
+ * @param hi Upper clamp bound.
+ */
+static inline void qx_simd_ramp_mul(const float* in, float* out, size_t n,
+                                    float start, float delta,
+                                    float lo, float hi)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 offs = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f,
+                                                   5.0f, 6.0f, 7.0f, 8.0f);
+                const __m256 vstart = _mm256_set1_ps(start);
+                const __m256 vdelta = _mm256_set1_ps(delta);
+                const __m256 vlo = _mm256_set1_ps(lo);
+                const __m256 vhi = _mm256_set1_ps(hi);
+                for (; i + 8 <= n; i += 8) {
+                        __m256 idx = _mm256_add_ps(_mm256_set1_ps((float)i), offs);
+                        __m256 g = _mm256_add_ps(vstart, _mm256_mul_ps(vdelta, idx));
+                        g = _mm256_min_ps(_mm256_max_ps(g, vlo), vhi);
+                        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), g));
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 offs = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+                const __m128 vstart = _mm_set1_ps(start);
+                const __m128 vdelta = _mm_set1_ps(delta);
+                const __m128 vlo = _mm_set1_ps(lo);
+                const __m128 vhi = _mm_set1_ps(hi);
+                for (; i + 4 <= n; i += 4) {
+                        __m128 idx = _mm_add_ps(_mm_set1_ps((float)i), offs);
+                        __m128 g = _mm_add_ps(vstart, _mm_mul_ps(vdelta, idx));
+                        g = _mm_min_ps(_mm_max_ps(g, vlo), vhi);
+                        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), g));
+                }
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                const float offs_init[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+                const float32x4_t offs = vld1q_f32(offs_init);
+                const float32x4_t vstart = vdupq_n_f32(start);
+                const float32x4_t vdelta = vdupq_n_f32(delta);
+                const float32x4_t vlo = vdupq_n_f32(lo);
+                const float32x4_t vhi = vdupq_n_f32(hi);
+                for (; i + 4 <= n; i += 4) {
+                        float32x4_t idx = vaddq_f32(vdupq_n_f32((float)i), offs);
+                        float32x4_t g = vaddq_f32(vstart, vmulq_f32(vdelta, idx));
+                        g = vminq_f32(vmaxq_f32(g, vlo), vhi);
+                        vst1q_f32(out + i, vmulq_f32(vld1q_f32(in + i), g));
+                }
+        }
+#endif
+        for (; i < n; i++) {
+                float g = start + delta * ((float)i + 1.0f);
+                out[i] = in[i] * (g < lo ? lo : (g > hi ? hi : g));
+        }
+}
+
+/**
+ * @brief Fill a buffer with a geometric ramp.
+ *
+ * out[i] = offset + scale * ratio^(i + 1)
+ *
+ * Used for exponential (one-pole) and multiplicative (dB-domain) ramps.
+ *
+ * @param out Output buffer.
+ * @param n Number of samples.
+ * @param offset Value the ramp converges to.
+ * @param scale Distance from @p offset before the first sample.
+ * @param ratio Multiplier per sample.
+ */
+static inline void qx_simd_geometric_fill(float* out, size_t n,
+                                          float offset, float scale, float ratio)
+{
+        size_t i = 0;
+        float g = scale * ratio;
+#if defined(QX_SIMD_AVX)
+        if (n >= 8) {
+                float lanes[8];
+                for (int k = 0; k < 8; k++) {
+                        lanes[k] = g;
+                        g *= ratio;
+                }
+                const __m256 voff = _mm256_set1_ps(offset);
+                float r8 = ratio * ratio;
+                r8 *= r8;
+                r8 *= r8;
+                const __m256 vr8 = _mm256_set1_ps(r8);
+                __m256 p = _mm256_loadu_ps(lanes);
+                for (; i + 8 <= n; i += 8) {
+                        _mm256_storeu_ps(out + i, _mm256_add_ps(voff, p));
+                        p = _mm256_mul_ps(p, vr8);
+                }
+                g = _mm256_cvtss_f32(p);
+        }
+#elif defined(QX_SIMD_SSE2) || defined(QX_SIMD_NEON)
+        if (n >= 4) {
+                float lanes[4];
+                for (int k = 0; k < 4; k++) {
+                        lanes[k] = g;
+                        g *= ratio;
+                }
+                float r4 = ratio * ratio;
+                r4 *= r4;
+#if defined(QX_SIMD_SSE2)
+                const __m128 voff = _mm_set1_ps(offset);
+                const __m128 vr4 = _mm_set1_ps(r4);
+                __m128 p = _mm_loadu_ps(lanes);
+                for (; i + 4 <= n; i += 4) {
+                        _mm_storeu_ps(out + i, _mm_add_ps(voff, p));
+                        p = _mm_mul_ps(p, vr4);
+                }
+                g = _mm_cvtss_f32(p);
+#else
+                const float32x4_t voff = vdupq_n_f32(offset);
+                float32x4_t p = vld1q_f32(lanes);
+                for (; i + 4 <= n; i += 4) {
+                        vst1q_f32(out + i, vaddq_f32(voff, p));
+                        p = vmulq_n_f32(p, r4);
+                }
+                g = vgetq_lane_f32(p, 0);
+#endif
+        }
+#endif
+        for (; i < n; i++) {
+                out[i] = offset + g;
+                g *= ratio;
+        }
+}
+
+/**
+ * @brief Multiply two buffers element-wise.
+ *
+ * @param a First input buffer.
+ * @param b Second input buffer.
+ * @param out Output buffer (may be the same as @p a or @p b).
+ * @param n Number of samples.
+ */
+static inline void qx_simd_mul(const float* a, const float* b, float* out, size_t n)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        for (; i + 8 <= n; i += 8)
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i),
+                                                        _mm256_loadu_ps(b + i)));
+#endif
+#if defined(QX_SIMD_SSE2)
+        for (; i + 4 <= n; i += 4)
+                _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4)
+                vst1q_f32(out + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+#endif
+        for (; i < n; i++)
+                out[i] = a[i] * b[i];
+}
+
+/**
+ * @brief Fill a buffer with a constant value.
+ *
+ * @param out Output buffer.
+ * @param n Number of samples.
+ * @param value Value to write.
+ */
+static inline void qx_simd_fill(float* out, size_t n, float value)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 v = _mm256_set1_ps(value);
+                for (; i + 8 <= n; i += 8)
+                        _mm256_storeu_ps(out + i, v);
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 v = _mm_set1_ps(value);
+                for (; i + 4 <= n; i += 4)
+                        _mm_storeu_ps(out + i, v);
+        }
+#elif defined(QX_SIMD_NEON)
+        {
+                const float32x4_t v = vdupq_n_f32(value);
+                for (; i + 4 <= n; i += 4)
+                        vst1q_f32(out + i, v);
+        }
+#endif
+        for (; i < n; i++)
+                out[i] = value;
+}
+
+/**
+ * @brief Multiply a buffer by a constant gain.
+ *
+ * Gains of exactly 0 and 1 are turned into memset/memcpy.
+ *
+ * @param in Input buffer.
+ * @param out Output buffer (may be the same as @p in).
+ * @param n Number of samples.
+ * @param gain Gain factor.
+ */
+static inline void qx_simd_scale(const float* in, float* out, size_t n, float gain)
+{
+        if (gain == 0.0f) {
+                memset(out, 0, n * sizeof(float));
+                return;
+        }
+
+        if (gain == 1.0f) {
+                if (in != out)
+                        memmove(out, in, n * sizeof(float));
+                return;
+        }
+
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 vg = _mm256_set1_ps(gain);
+                for (; i + 8 <= n; i += 8)
+                        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), vg));
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 vg = _mm_set1_ps(gain);
+                for (; i + 4 <= n; i += 4)
+                        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), vg));
+        }
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4)
+                vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(in + i), gain));
+#endif
+        for (; i < n; i++)
+                out[i] = in[i] * gain;
+}
+
+/**
+ * @brief Mix two buffers with per-sample gains.
+ *
+ * out[i] = a[i] * ga[i] + b[i] * gb[i]
+ *
+ * @param a First input buffer.
+ * @param ga Gains of @p a.
+ * @param b Second input buffer.
+ * @param gb Gains of @p b.
+ * @param out Output buffer (may be the same as @p a or @p b).
+ * @param n Number of samples.
+ */
+static inline void qx_simd_mix(const float* a, const float* ga,
+                               const float* b, const float* gb,
+                               float* out, size_t n)
+{
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        for (; i + 8 <= n; i += 8) {
+                __m256 va = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(ga + i));
+                __m256 vb = _mm256_mul_ps(_mm256_loadu_ps(b + i), _mm256_loadu_ps(gb + i));
+                _mm256_storeu_ps(out + i, _mm256_add_ps(va, vb));
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        for (; i + 4 <= n; i += 4) {
+                __m128 va = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(ga + i));
+                __m128 vb = _mm_mul_ps(_mm_loadu_ps(b + i), _mm_loadu_ps(gb + i));
+                _mm_storeu_ps(out + i, _mm_add_ps(va, vb));
+        }
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4) {
+                float32x4_t va = vmulq_f32(vld1q_f32(a + i), vld1q_f32(ga + i));
+                vst1q_f32(out + i, vmlaq_f32(va, vld1q_f32(b + i), vld1q_f32(gb + i)));
+        }
+#endif
+        for (; i < n; i++)
+                out[i] = a[i] * ga[i] + b[i] * gb[i];
+}
+
+/**
+ * @brief Mix two buffers with constant gains.
+ *
+ * out[i] = a[i] * ga + b[i] * gb. A zero gain turns it into qx_simd_scale()
+ * of the other buffer.
+ *
+ * @param a First input buffer.
+ * @param b Second input buffer.
+ * @param out Output buffer (may be the same as @p a or @p b).
+ * @param n Number of samples.
+ * @param ga Gain of @p a.
+ * @param gb Gain of @p b.
+ */
+static inline void qx_simd_mix_gain(const float* a, const float* b, float* out,
+                                    size_t n, float ga, float gb)
+{
+        if (gb == 0.0f) {
+                qx_simd_scale(a, out, n, ga);
+                return;
+        }
+
+        if (ga == 0.0f) {
+                qx_simd_scale(b, out, n, gb);
+                return;
+        }
+
+        size_t i = 0;
+#if defined(QX_SIMD_AVX)
+        {
+                const __m256 vga = _mm256_set1_ps(ga);
+                const __m256 vgb = _mm256_set1_ps(gb);
+                for (; i + 8 <= n; i += 8) {
+                        __m256 va = _mm256_mul_ps(_mm256_loadu_ps(a + i), vga);
+                        __m256 vb = _mm256_mul_ps(_mm256_loadu_ps(b + i), vgb);
+                        _mm256_storeu_ps(out + i, _mm256_add_ps(va, vb));
+                }
+        }
+#endif
+#if defined(QX_SIMD_SSE2)
+        {
+                const __m128 vga = _mm_set1_ps(ga);
+                const __m128 vgb = _mm_set1_ps(gb);
+                for (; i + 4 <= n; i += 4) {
+                        __m128 va = _mm_mul_ps(_mm_loadu_ps(a + i), vga);
+                        __m128 vb = _mm_mul_ps(_mm_loadu_ps(b + i), vgb);
+                        _mm_storeu_ps(out + i, _mm_add_ps(va, vb));
+                }
+        }
+#elif defined(QX_SIMD_NEON)
+        for (; i + 4 <= n; i += 4) {
+                float32x4_t va = vmulq_n_f32(vld1q_f32(a + i), ga);
+                vst1q_f32(out + i, vmlaq_n_f32(va, vld1q_f32(b + i), gb));
+        }
+#endif
+        for (; i < n; i++)
+                out[i] = a[i] * ga + b[i] * gb;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // QX_SIMD_H
@@ -28,23 +28,51 @@
 #define QX_SMOOTHER_H
 
 #include "qx_math.h"
+#include "qx_simd.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Shape of the transition from the current value to the target.
+ */
+enum qx_smoother_shape {
+    QX_SMOOTHER_LINEAR = 0,    /**< Constant increment per frame */
+    QX_SMOOTHER_EXPONENTIAL,   /**< One-pole lowpass, settles to QX_SMOOTHER_EXP_RESIDUAL of the jump */
+    QX_SMOOTHER_LOGARITHMIC,   /**< Constant ratio per frame (linear in dB), for values of the same sign */
+    QX_SMOOTHER_SCURVE,        /**< Smoothstep (3t^2 - 2t^3), zero slope at both ends */
+};
+
+/**
+ * @brief Remaining fraction of the jump when an exponential ramp snaps to the target (-80 dB).
+ */
+#define QX_SMOOTHER_EXP_RESIDUAL 1e-4f
+
 /**
  * @brief Generic float smoother.
  *
  * Smoothly interpolates a float value from current to target
  * over a fixed number of frames (samples or blocks).
+ *
+ * The coefficients of the selected shape are computed once in
+ * qx_smoother_set_target(). The linear, exponential and logarithmic
+ * shapes share the update current = current * coeff + step.
+ * The target is always reached exactly after `frames` frames.
  */
 typedef struct qx_smoother {
     float current;    /**< Current value */
     float target;     /**< Target value */
-    float step;       /**< Increment per frame */
+    float step;       /**< Increment per frame (phase increment for the S-curve) */
     size_t frames;    /**< Number of frames to reach target */
+    enum qx_smoother_shape shape; /**< Transition shape */
+    float coeff;      /**< Multiplier per frame (1 for the linear shape) */
+    float start;      /**< Value at the start of the transition */
+    float phase;      /**< Transition position [0..1] (S-curve) */
+    size_t remaining; /**< Frames until the target is reached */
 } qx_smoother;
 
 /**
@@ -60,6 +88,22 @@ static inline void qx_smoother_init(qx_smoother* s, float initial, size_t frames
     s->target = initial;
     s->frames = frames > 0 ? frames : 1;
     s->step = 0.0f;
+    s->shape = QX_SMOOTHER_LINEAR;
+    s->coeff = 1.0f;
+    s->start = initial;
+    s->phase = 1.0f;
+    s->remaining = 0;
+}
+
+/**
+ * @brief Set the transition shape.
+ *
+ * @param s Pointer to qx_smoother
+ * @param shape Shape used from the next qx_smoother_set_target() call
+ */
+static inline void qx_smoother_set_shape(qx_smoother* s, enum qx_smoother_shape shape)
+{
+    s->shape = shape;
 }
 
 /**
@@ -67,11 +111,36 @@ static inline void qx_smoother_init(qx_smoother* s, float initial, size_t frames
  *
  * @param s Pointer to qx_smoother
  * @param target New target value
+ *
+ * The logarithmic shape needs a current value and a target of the same
+ * sign; otherwise the transition is linear.
  */
 static inline void qx_smoother_set_target(qx_smoother* s, float target)
 {
     s->target = target;
+    s->start = s->current;
+    s->phase = 0.0f;
+    s->remaining = target != s->current ? s->frames : 0;
+    s->coeff = 1.0f;
     s->step = (s->target - s->current) / (float)s->frames;
+
+    switch (s->shape) {
+    case QX_SMOOTHER_EXPONENTIAL:
+        s->coeff = powf(QX_SMOOTHER_EXP_RESIDUAL, 1.0f / (float)s->frames);
+        s->step = target * (1.0f - s->coeff);
+        break;
+    case QX_SMOOTHER_LOGARITHMIC:
+        if (s->current * target > 0.0f) {
+            s->coeff = powf(target / s->current, 1.0f / (float)s->frames);
+            s->step = 0.0f;
+        }
+        break;
+    case QX_SMOOTHER_SCURVE:
+        s->step = 1.0f / (float)s->frames;
+        break;
+    default:
+        break;
+    }
 }
 
 /**
@@ -79,18 +148,29 @@ static inline void qx_smoother_set_target(qx_smoother* s, float target)
  *
  * @param s Pointer to qx_smoother
  * @return Smoothed value
+ *
+ * Branches on the remaining frames and on the shape. Both stay the same
+ * for long runs of calls and predict well, and a settled smoother
+ * returns after one compare. Computing every shape and selecting the
+ * result is slower. For per-sample work without branches use
+ * qx_smoother_process_block().
  */
 static inline float qx_smoother_next(qx_smoother* s)
 {
-    if (s->current == s->target)
+    if (s->remaining == 0)
         return s->current;
 
-    s->current += s->step;
-
-    // Clamp to target to avoid overshoot
-    if ((s->step > 0.0f && s->current > s->target) ||
-        (s->step < 0.0f && s->current < s->target)) {
+    if (--s->remaining == 0) {
         s->current = s->target;
+        return s->current;
+    }
+
+    if (s->shape == QX_SMOOTHER_SCURVE) {
+        s->phase += s->step;
+        float t = s->phase;
+        s->current = s->start + (s->target - s->start) * t * t * (3.0f - 2.0f * t);
+    } else {
+        s->current = s->current * s->coeff + s->step;
     }
 
     return s->current;
@@ -107,6 +187,420 @@ static inline float qx_smoother_get(const qx_smoother* s)
     return s->current;
 }
 
+/**
+ * @brief Number of frames until the target is reached.
+ *
+ * @param s Pointer to qx_smoother
+ * @return Exact number of qx_smoother_next() calls after which the
+ *         value equals the target; 0 when the smoother has settled.
+ */
+static inline size_t qx_smoother_remaining(const qx_smoother* s)
+{
+    return s->remaining;
+}
+
+/**
+ * @brief Number of ramping frames in the next block.
+ *
+ * @param s Pointer to qx_smoother
+ * @param frames Maximum number of frames to look ahead
+ * @return Number of leading frames that are still ramping (at most @p frames).
+ *         The frames after them have the target value.
+ */
+static inline size_t qx_smoother_ramp_frames(const qx_smoother* s, size_t frames)
+{
+    if (s->remaining == 0)
+        return 0;
+    return s->remaining - 1 < frames ? s->remaining - 1 : frames;
+}
+
+/**
+ * @brief Advance the smoother by a block of frames without producing output.
+ *
+ * @param s Pointer to qx_smoother
+ * @param frames Number of frames
+ */
+static inline void qx_smoother_advance(qx_smoother* s, size_t frames)
+{
+    if (frames == 0 || s->remaining == 0)
+        return;
+
+    if (frames >= s->remaining) {
+        s->current = s->target;
+        s->phase = 1.0f;
+        s->remaining = 0;
+        return;
+    }
+
+    s->remaining -= frames;
+    if (s->shape == QX_SMOOTHER_SCURVE) {
+        s->phase += s->step * (float)frames;
+        float t = s->phase;
+        s->current = s->start + (s->target - s->start) * t * t * (3.0f - 2.0f * t);
+    } else if (s->coeff == 1.0f) {
+        s->current += s->step * (float)frames;
+    } else {
+        float offset = s->step / (1.0f - s->coeff);
+        s->current = offset + (s->current - offset) * powf(s->coeff, (float)frames);
+    }
+}
+
+/**
+ * @brief Compute the ramping part of the next block.
+ *
+ * @param s Pointer to qx_smoother
+ * @param out Output buffer
+ * @param n Number of frames, at most qx_smoother_ramp_frames()
+ */
+static inline void qx_smoother_ramp(const qx_smoother* s, float* out, size_t n)
+{
+    if (s->shape == QX_SMOOTHER_SCURVE) {
+        float delta = s->target - s->start;
+        qx_simd_ramp_fill(out, n, s->phase, s->step, 0.0f, 1.0f);
+        for (size_t i = 0; i < n; i++) {
+            float t = out[i];
+            out[i] = s->start + delta * t * t * (3.0f - 2.0f * t);
+        }
+    } else if (s->coeff == 1.0f) {
+        float lo = s->current < s->target ? s->current : s->target;
+        float hi = s->current < s->target ? s->target : s->current;
+        qx_simd_ramp_fill(out, n, s->current, s->step, lo, hi);
+    } else {
+        float offset = s->step / (1.0f - s->coeff);
+        qx_simd_geometric_fill(out, n, offset, s->current - offset, s->coeff);
+    }
+}
+
+/**
+ * @brief Number of frames per chunk when a ramp is applied as a gain.
+ */
+#define QX_SMOOTHER_CHUNK_FRAMES 64
+
+/**
+ * @brief Fill a buffer with the next smoothed values.
+ *
+ * @param s Pointer to qx_smoother
+ * @param out Output buffer
+ * @param frames Number of frames
+ *
+ * Produces the values of calling qx_smoother_next() @p frames times,
+ * to float rounding: the ramp is computed in closed form with SIMD
+ * instead of by repeated steps, and the target is reached exactly on the
+ * same frame. The settled part is a constant fill, without per-sample
+ * branches.
+ */
+static inline void qx_smoother_process_block(qx_smoother* s, float* out, size_t frames)
+{
+    size_t ramp = qx_smoother_ramp_frames(s, frames);
+    if (ramp > 0)
+        qx_smoother_ramp(s, out, ramp);
+
+    if (ramp < frames)
+        qx_simd_fill(out + ramp, frames - ramp, s->target);
+
+    qx_smoother_advance(s, frames);
+}
+
+/**
+ * @brief Multiply a buffer by the next smoothed values.
+ *
+ * @param s Pointer to qx_smoother
+ * @param in Input buffer
+ * @param out Output buffer (may be the same as @p in)
+ * @param frames Number of frames
+ *
+ * out[i] = in[i] * qx_smoother_next(s), computed per block.
+ */
+static inline void qx_smoother_apply_gain_block(qx_smoother* s,
+                                                const float* in,
+                                                float* out,
+                                                size_t frames)
+{
+    size_t ramp = qx_smoother_ramp_frames(s, frames);
+    if (ramp > 0 && s->shape != QX_SMOOTHER_SCURVE && s->coeff == 1.0f) {
+        float lo = s->current < s->target ? s->current : s->target;
+        float hi = s->current < s->target ? s->target : s->current;
+        qx_simd_ramp_mul(in, out, ramp, s->current, s->step, lo, hi);
+    } else if (ramp > 0) {
+        float gain[QX_SMOOTHER_CHUNK_FRAMES];
+        qx_smoother chunk = *s;
+        for (size_t pos = 0; pos < ramp; pos += QX_SMOOTHER_CHUNK_FRAMES) {
+            size_t n = ramp - pos;
+            if (n > QX_SMOOTHER_CHUNK_FRAMES)
+                n = QX_SMOOTHER_CHUNK_FRAMES;
+            qx_smoother_ramp(&chunk, gain, n);
+            qx_simd_mul(in + pos, gain, out + pos, n);
+            qx_smoother_advance(&chunk, n);
+        }
+    }
+
+    if (ramp < frames)
+        qx_simd_scale(in + ramp, out + ramp, frames - ramp, s->target);
+
+    qx_smoother_advance(s, frames);
+}
+
+/**
+ * @brief Marks a smoother that is not in the active list of a bank.
+ */
+#define QX_SMOOTHER_BANK_INACTIVE UINT32_MAX
+
+/**
+ * @brief Structure-of-arrays storage for many smoothers.
+ *
+ * Each field of qx_smoother is stored in its own array. Smoothers that have
+ * not reached their target are kept in a compact list of active indices,
+ * so processing cost scales with the number of moving parameters
+ * instead of the total number of parameters.
+ */
+typedef struct qx_smoother_bank {
+    float* current;       /**< Current values */
+    float* target;        /**< Target values */
+    float* step;          /**< Increments per frame */
+    float* coeff;         /**< Multipliers per frame */
+    float* start;         /**< Values at the start of the transitions */
+    float* phase;         /**< Transition positions (S-curve) */
+    size_t* frames;       /**< Number of frames to reach the target */
+    size_t* remaining;    /**< Frames until the target is reached */
+    uint8_t* shape;       /**< Transition shapes (enum qx_smoother_shape) */
+    uint32_t* active;     /**< Indices of the active smoothers */
+    uint32_t* active_pos; /**< Position in the active list, or QX_SMOOTHER_BANK_INACTIVE */
+    size_t active_count;  /**< Number of active smoothers */
+    size_t count;         /**< Number of smoothers */
+} qx_smoother_bank;
+
+/**
+ * @brief Release the memory of a smoother bank.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ */
+static inline void qx_smoother_bank_free(qx_smoother_bank* bank)
+{
+    qx_simd_aligned_free(bank->current);
+    qx_simd_aligned_free(bank->target);
+    qx_simd_aligned_free(bank->step);
+    qx_simd_aligned_free(bank->coeff);
+    qx_simd_aligned_free(bank->start);
+    qx_simd_aligned_free(bank->phase);
+    qx_simd_aligned_free(bank->frames);
+    qx_simd_aligned_free(bank->remaining);
+    qx_simd_aligned_free(bank->shape);
+    qx_simd_aligned_free(bank->active);
+    qx_simd_aligned_free(bank->active_pos);
+    memset(bank, 0, sizeof(*bank));
+}
+
+/**
+ * @brief Initialize a smoother bank.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param count Number of smoothers
+ * @param initial Initial value of every smoother
+ * @param frames Number of frames over which to smooth
+ * @return true on success, false if memory allocation failed
+ *
+ * Every smoother is initialized as with qx_smoother_init().
+ * The bank must be released with qx_smoother_bank_free().
+ */
+static inline bool qx_smoother_bank_init(qx_smoother_bank* bank,
+                                         size_t count,
+                                         float initial,
+                                         size_t frames)
+{
+    memset(bank, 0, sizeof(*bank));
+    bank->current = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->target = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->step = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->coeff = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->start = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->phase = (float*)qx_simd_aligned_alloc(count * sizeof(float));
+    bank->frames = (size_t*)qx_simd_aligned_alloc(count * sizeof(size_t));
+    bank->remaining = (size_t*)qx_simd_aligned_alloc(count * sizeof(size_t));
+    bank->shape = (uint8_t*)qx_simd_aligned_alloc(count * sizeof(uint8_t));
+    bank->active = (uint32_t*)qx_simd_aligned_alloc(count * sizeof(uint32_t));
+    bank->active_pos = (uint32_t*)qx_simd_aligned_alloc(count * sizeof(uint32_t));
+    if (!bank->current || !bank->target || !bank->step || !bank->coeff
+        || !bank->start || !bank->phase || !bank->frames || !bank->remaining
+        || !bank->shape || !bank->active || !bank->active_pos) {
+        qx_smoother_bank_free(bank);
+        return false;
+    }
+
+    qx_smoother proto;
+    qx_smoother_init(&proto, initial, frames);
+    for (size_t i = 0; i < count; i++) {
+        bank->current[i] = proto.current;
+        bank->target[i] = proto.target;
+        bank->step[i] = proto.step;
+        bank->coeff[i] = proto.coeff;
+        bank->start[i] = proto.start;
+        bank->phase[i] = proto.phase;
+        bank->frames[i] = proto.frames;
+        bank->remaining[i] = proto.remaining;
+        bank->shape[i] = (uint8_t)proto.shape;
+        bank->active_pos[i] = QX_SMOOTHER_BANK_INACTIVE;
+    }
+
+    bank->count = count;
+    return true;
+}
+
+/**
+ * @brief Copy the state of one smoother of the bank into a qx_smoother.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @param s Destination smoother
+ */
+static inline void qx_smoother_bank_load(const qx_smoother_bank* bank,
+                                         size_t index,
+                                         qx_smoother* s)
+{
+    s->current = bank->current[index];
+    s->target = bank->target[index];
+    s->step = bank->step[index];
+    s->frames = bank->frames[index];
+    s->shape = (enum qx_smoother_shape)bank->shape[index];
+    s->coeff = bank->coeff[index];
+    s->start = bank->start[index];
+    s->phase = bank->phase[index];
+    s->remaining = bank->remaining[index];
+}
+
+/**
+ * @brief Copy the state of a qx_smoother into one smoother of the bank.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @param s Source smoother
+ *
+ * Adds the smoother to the active list if it has not settled
+ * and removes it otherwise.
+ */
+static inline void qx_smoother_bank_store(qx_smoother_bank* bank,
+                                          size_t index,
+                                          const qx_smoother* s)
+{
+    bank->current[index] = s->current;
+    bank->target[index] = s->target;
+    bank->step[index] = s->step;
+    bank->frames[index] = s->frames;
+    bank->shape[index] = (uint8_t)s->shape;
+    bank->coeff[index] = s->coeff;
+    bank->start[index] = s->start;
+    bank->phase[index] = s->phase;
+    bank->remaining[index] = s->remaining;
+
+    uint32_t pos = bank->active_pos[index];
+    if (s->remaining > 0 && pos == QX_SMOOTHER_BANK_INACTIVE) {
+        bank->active_pos[index] = (uint32_t)bank->active_count;
+        bank->active[bank->active_count++] = (uint32_t)index;
+    } else if (s->remaining == 0 && pos != QX_SMOOTHER_BANK_INACTIVE) {
+        uint32_t last = bank->active[--bank->active_count];
+        bank->active[pos] = last;
+        bank->active_pos[last] = pos;
+        bank->active_pos[index] = QX_SMOOTHER_BANK_INACTIVE;
+    }
+}
+
+/**
+ * @brief Set the number of frames of one smoother.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @param frames Number of frames used from the next target change
+ */
+static inline void qx_smoother_bank_set_frames(qx_smoother_bank* bank, size_t index, size_t frames)
+{
+    bank->frames[index] = frames > 0 ? frames : 1;
+}
+
+/**
+ * @brief Set the transition shape of one smoother.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @param shape Shape used from the next target change
+ */
+static inline void qx_smoother_bank_set_shape(qx_smoother_bank* bank,
+                                              size_t index,
+                                              enum qx_smoother_shape shape)
+{
+    bank->shape[index] = (uint8_t)shape;
+}
+
+/**
+ * @brief Set a new target value for one smoother and activate it.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @param target New target value
+ */
+static inline void qx_smoother_bank_set_target(qx_smoother_bank* bank, size_t index, float target)
+{
+    qx_smoother s;
+    qx_smoother_bank_load(bank, index, &s);
+    qx_smoother_set_target(&s, target);
+    qx_smoother_bank_store(bank, index, &s);
+}
+
+/**
+ * @brief Get the current value of one smoother.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param index Smoother index
+ * @return Current value
+ */
+static inline float qx_smoother_bank_get(const qx_smoother_bank* bank, size_t index)
+{
+    return bank->current[index];
+}
+
+/**
+ * @brief Process a block for the active smoothers only.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @param outs Array of bank->count output buffers indexed by smoother, or NULL
+ *             to only advance the smoothers (block-rate smoothing). Entries of
+ *             inactive smoothers are not written; their value is
+ *             qx_smoother_bank_get(). A NULL entry only advances that smoother.
+ * @param frames Number of frames
+ *
+ * Smoothers that reach their target are removed from the active list.
+ */
+static inline void qx_smoother_bank_process(qx_smoother_bank* bank,
+                                            float* const* outs,
+                                            size_t frames)
+{
+    size_t k = 0;
+    while (k < bank->active_count) {
+        uint32_t index = bank->active[k];
+        qx_smoother s;
+        qx_smoother_bank_load(bank, index, &s);
+
+        if (outs && outs[index])
+            qx_smoother_process_block(&s, outs[index], frames);
+        else
+            qx_smoother_advance(&s, frames);
+
+        // Storing a settled smoother moves the last active one into slot k
+        qx_smoother_bank_store(bank, index, &s);
+        if (s.remaining > 0)
+            k++;
+    }
+}
+
+/**
+ * @brief Number of smoothers that have not reached their target.
+ *
+ * @param bank Pointer to qx_smoother_bank
+ * @return Number of active smoothers
+ */
+static inline size_t qx_smoother_bank_active_count(const qx_smoother_bank* bank)
+{
+    return bank->active_count;
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,180 @@
+/**
+ * @file qx_dsp.c
+ * @brief CPU feature detection and kernel table selection.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "qx_dsp_kernels.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(QX_DSP_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+static const char* const qx_dsp_isa_names[QX_DSP_ISA_COUNT] = {
+        "scalar", "sse2", "avx", "avx2", "avx512", "neon"
+};
+
+static _Atomic(const struct qx_dsp_kernels*) qx_dsp_active;
+
+#if defined(QX_DSP_X86)
+static void qx_dsp_cpuid(unsigned int leaf, unsigned int sub, unsigned int regs[4])
+{
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)sub);
+        for (int i = 0; i < 4; i++)
+                regs[i] = (unsigned int)r[i];
+#else
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long qx_dsp_xgetbv(void)
+{
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+#endif
+
+/**
+ * @brief Get the table of an instruction set if it is compiled in and runs on this CPU.
+ */
+static const struct qx_dsp_kernels* qx_dsp_table(enum qx_dsp_isa isa)
+{
+#if defined(QX_DSP_X86)
+        unsigned int regs[4];
+        qx_dsp_cpuid(0, 0, regs);
+        unsigned int max_leaf = regs[0];
+        qx_dsp_cpuid(1, 0, regs);
+        bool sse2 = (regs[3] >> 26) & 1;
+        bool osxsave = (regs[2] >> 27) & 1;
+        bool avx = osxsave && ((regs[2] >> 28) & 1);
+
+        // The OS must save the YMM (and for AVX-512 the ZMM) registers
+        unsigned long long xcr0 = osxsave ? qx_dsp_xgetbv() : 0;
+        avx = avx && (xcr0 & 0x6) == 0x6;
+        bool avx2 = false;
+        bool avx512 = false;
+        if (max_leaf >= 7) {
+                qx_dsp_cpuid(7, 0, regs);
+                avx2 = avx && ((regs[1] >> 5) & 1);
+                avx512 = avx2 && ((regs[1] >> 16) & 1) && (xcr0 & 0xe6) == 0xe6;
+        }
+
+        switch (isa) {
+        case QX_DSP_ISA_SSE2:
+                return sse2 ? &qx_dsp_kernels_sse2 : NULL;
+        case QX_DSP_ISA_AVX:
+                return avx ? &qx_dsp_kernels_avx : NULL;
+        case QX_DSP_ISA_AVX2:
+                return avx2 ? &qx_dsp_kernels_avx2 : NULL;
+        case QX_DSP_ISA_AVX512:
+                return avx512 ? &qx_dsp_kernels_avx512 : NULL;
+        default:
+                break;
+        }
+#endif
+#if defined(QX_DSP_NEON)
+        if (isa == QX_DSP_ISA_NEON)
+                return &qx_dsp_kernels_neon;
+#endif
+        return isa == QX_DSP_ISA_SCALAR ? &qx_dsp_kernels_scalar : NULL;
+}
+
+/**
+ * @brief Select the table forced by QX_DSP_ISA or the best one for the CPU.
+ */
+static const struct qx_dsp_kernels* qx_dsp_select(void)
+{
+        const struct qx_dsp_kernels* table = NULL;
+
+        const char* forced = getenv("QX_DSP_ISA");
+        if (forced) {
+                for (int isa = 0; isa < QX_DSP_ISA_COUNT && !table; isa++) {
+                        if (strcmp(forced, qx_dsp_isa_names[isa]) == 0)
+                                table = qx_dsp_table((enum qx_dsp_isa)isa);
+                }
+        }
+
+        for (int isa = QX_DSP_ISA_COUNT - 1; isa >= 0 && !table; isa--)
+                table = qx_dsp_table((enum qx_dsp_isa)isa);
+        return table;
+}
+
+void qx_dsp_init(void)
+{
+        atomic_store_explicit(&qx_dsp_active, qx_dsp_select(), memory_order_release);
+}
+
+const struct qx_dsp_kernels* qx_dsp(void)
+{
+        const struct qx_dsp_kernels* table = atomic_load_explicit(&qx_dsp_active, memory_order_acquire);
+        if (!table) {
+                // Only replace NULL, a concurrent qx_dsp_set_isa() or first call wins
+                const struct qx_dsp_kernels* selected = qx_dsp_select();
+                if (atomic_compare_exchange_strong_explicit(&qx_dsp_active, &table, selected,
+                                                            memory_order_acq_rel,
+                                                            memory_order_acquire))
+                        table = selected;
+        }
+        return table;
+}
+
+bool qx_dsp_isa_supported(enum qx_dsp_isa isa)
+{
+        return qx_dsp_table(isa) != NULL;
+}
+
+bool qx_dsp_set_isa(enum qx_dsp_isa isa)
+{
+        const struct qx_dsp_kernels* table = qx_dsp_table(isa);
+        if (!table)
+                return false;
+
+        atomic_store_explicit(&qx_dsp_active, table, memory_order_release);
+        return true;
+}
+
+enum qx_dsp_isa qx_dsp_get_isa(void)
+{
+        return qx_dsp()->isa;
+}
+
+const char* qx_dsp_isa_name(enum qx_dsp_isa isa)
+{
+        return (isa >= 0 && isa < QX_DSP_ISA_COUNT) ? qx_dsp_isa_names[isa] : "unknown";
+}
@@ -0,0 +1,41 @@
+/**
+ * @file qx_dsp_avx2.c
+ * @brief AVX2 kernel table, compiled with -mavx2.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "qx_dsp_kernels.h"
+
+#if defined(QX_DSP_X86)
+#if !defined(__AVX2__)
+#error "qx_dsp_avx2.c must be compiled with AVX2 enabled (-mavx2)"
+#endif
+#if defined(__AVX512F__)
+#error "qx_dsp_avx2.c must not be compiled with AVX-512 enabled, the table would not run on every AVX2 CPU"
+#endif
+#define QX_DSP_KERNELS_NAME qx_dsp_kernels_avx2
+#define QX_DSP_KERNELS_ISA QX_DSP_ISA_AVX2
+#include "qx_dsp_kernels.h"
+#else
+typedef int qx_dsp_avx2_unused;
+#endif
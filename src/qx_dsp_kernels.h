@@ -0,0 +1,143 @@
+/**
+ * @file qx_dsp_kernels.h
+ * @brief Kernel table definition shared by the per instruction set sources.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Private header of the dispatch library.
+ *
+ * Without QX_DSP_KERNELS_NAME it only declares the tables. A per instruction
+ * set source defines QX_DSP_KERNELS_NAME and QX_DSP_KERNELS_ISA and includes
+ * this header after the compiler flags have enabled the instruction set;
+ * the table is then filled with the header functions compiled for it.
+ */
+
+#ifndef QX_DSP_KERNELS_H
+#define QX_DSP_KERNELS_H
+
+#include "qx_dsp.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define QX_DSP_X86 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define QX_DSP_NEON 1
+#endif
+
+extern const struct qx_dsp_kernels qx_dsp_kernels_scalar;
+#if defined(QX_DSP_X86)
+extern const struct qx_dsp_kernels qx_dsp_kernels_sse2;
+extern const struct qx_dsp_kernels qx_dsp_kernels_avx;
+extern const struct qx_dsp_kernels qx_dsp_kernels_avx2;
+extern const struct qx_dsp_kernels qx_dsp_kernels_avx512;
+#endif
+#if defined(QX_DSP_NEON)
+extern const struct qx_dsp_kernels qx_dsp_kernels_neon;
+#endif
+
+#endif // QX_DSP_KERNELS_H
+
+#if defined(QX_DSP_KERNELS_NAME)
+
+#include "qx_crossfader.h"
+#include "qx_delay_line.h"
+#include "qx_distribution.h"
+#include "qx_fader.h"
+#include "qx_interp.h"
+#include "qx_math.h"
+#include "qx_noise.h"
+#include "qx_random_engine.h"
+#include "qx_randomizer.h"
+#include "qx_simd.h"
+#include "qx_smoother.h"
+
+const struct qx_dsp_kernels QX_DSP_KERNELS_NAME = {
+        .isa = QX_DSP_KERNELS_ISA,
+
+        .simd_ramp_fill = qx_simd_ramp_fill,
+        .simd_ramp_mul = qx_simd_ramp_mul,
+        .simd_mul = qx_simd_mul,
+        .simd_scale = qx_simd_scale,
+        .simd_mix = qx_simd_mix,
+        .simd_mix_gain = qx_simd_mix_gain,
+
+        .fader_process_block = qx_fader_process_block,
+        .fader_process_block_out = qx_fader_process_block_out,
+        .fader_process_block_end = qx_fader_process_block_end,
+        .fader_process_block_end_out = qx_fader_process_block_end_out,
+        .fader_process_interleaved = qx_fader_process_interleaved,
+        .fader_process_interleaved_out = qx_fader_process_interleaved_out,
+        .fader_bank_advance = qx_fader_bank_advance,
+        .fader_bank_set_time = qx_fader_bank_set_time,
+        .fader_bank_set_sample_rate = qx_fader_bank_set_sample_rate,
+        .fader_bank_process = qx_fader_bank_process,
+        .fader_curve_array = qx_fader_curve_array,
+
+        .crossfader_process_block = qx_crossfader_process_block,
+
+        .smoother_process_block = qx_smoother_process_block,
+        .smoother_apply_gain_block = qx_smoother_apply_gain_block,
+        .smoother_bank_process = qx_smoother_bank_process,
+
+        .randomizer_fill = qx_randomizer_fill,
+        .randomizer_fill_at = qx_randomizer_fill_at,
+        .random_engine_fill_u32 = qx_random_engine_fill_u32,
+        .random_fill_at = qx_random_fill_at,
+        .randomizer_fill_u32 = qx_randomizer_fill_u32,
+
+        .dist_normal_fill = qx_dist_normal_fill,
+        .dist_exponential_fill = qx_dist_exponential_fill,
+        .dist_triangular_fill = qx_dist_triangular_fill,
+        .dist_icdf_fill = qx_dist_icdf_fill,
+
+        .noise_fill = qx_noise_fill,
+
+        .normalize_array_float = qx_normalize_array_float,
+        .normalize_clamp_array_float = qx_normalize_clamp_array_float,
+        .denormalize_array_float = qx_denormalize_array_float,
+        .denormalize_clamp_array_float = qx_denormalize_clamp_array_float,
+        .clamp_array_float = qx_clamp_array_float,
+        .normalize_array_double = qx_normalize_array_double,
+        .normalize_clamp_array_double = qx_normalize_clamp_array_double,
+        .denormalize_array_double = qx_denormalize_array_double,
+        .denormalize_clamp_array_double = qx_denormalize_clamp_array_double,
+        .clamp_array_double = qx_clamp_array_double,
+        .db_to_val_array = qx_db_to_val_array,
+        .val_to_db_array = qx_val_to_db_array,
+        .wrapf_array = qx_wrapf_array,
+        .phase_fill = qx_phase_fill,
+
+        .ring_read_linear_block = qx_ring_read_linear_block,
+        .ring_read_hermite_block = qx_ring_read_hermite_block,
+        .ring_read_lagrange4_block = qx_ring_read_lagrange4_block,
+        .ring_read_sinc_block = qx_ring_read_sinc_block,
+
+        .delay_line_read = qx_delay_line_read,
+        .delay_line_read_hermite = qx_delay_line_read_hermite,
+        .delay_line_read_fixed = qx_delay_line_read_fixed,
+        .delay_line_process = qx_delay_line_process,
+};
+
+#endif // QX_DSP_KERNELS_NAME
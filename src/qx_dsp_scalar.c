@@ -0,0 +1,41 @@
+/**
+ * @file qx_dsp_scalar.c
+ * @brief Portable scalar kernel table.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "qx_dsp_kernels.h"
+
+/*
+ * QX_NO_SIMD only disables the explicit intrinsics, the compiler may still
+ * vectorize loops for the enabled instruction set, so build this file for
+ * the baseline of the target.
+ */
+#if defined(QX_DSP_X86) && defined(__AVX__)
+#error "qx_dsp_scalar.c must be compiled for the baseline instruction set"
+#endif
+
+#define QX_NO_SIMD
+#define QX_DSP_KERNELS_NAME qx_dsp_kernels_scalar
+#define QX_DSP_KERNELS_ISA QX_DSP_ISA_SCALAR
+#include "qx_dsp_kernels.h"
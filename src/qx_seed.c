@@ -0,0 +1,40 @@
+/**
+ * @file qx_seed.c
+ * @brief Process-wide seed source of the compiled library.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * The one definition of the seed counter shared by the library and every
+ * module that includes qx_randomizer.h with QX_DSP_LIBRARY defined, see
+ * the comment above qx_seed_counter in qx_randomizer.h.
+ */
+
+#include "qx_randomizer.h"
+
+#if !defined(QX_DSP_LIBRARY)
+#error "qx_seed.c must be compiled with QX_DSP_LIBRARY defined"
+#endif
+
+QX_DSP_API atomic_uint qx_seed_counter = 0u;
+QX_DSP_API atomic_uint qx_seed_entropy = 0u;
@@ -0,0 +1,69 @@
+/**
+ * @file qx_test.h
+ * @brief Minimal check helpers shared by the tests.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef QX_TEST_H
+#define QX_TEST_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Every test is a program that returns nonzero when a check failed. A
+ * failed check prints its location and message and the test continues,
+ * so one run reports every mismatch.
+ */
+
+static int qx_test_failures;
+
+#define QX_CHECK(cond, ...)                                                     \
+        do {                                                                    \
+                if (!(cond)) {                                                  \
+                        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__);         \
+                        fprintf(stderr, __VA_ARGS__);                           \
+                        fputc('\n', stderr);                                    \
+                        qx_test_failures++;                                     \
+                }                                                               \
+        } while (0)
+
+static inline int qx_test_result(const char* name)
+{
+        printf("%s: %s\n", name, qx_test_failures ? "FAILED" : "passed");
+        return qx_test_failures ? 1 : 0;
+}
+
+/** Number of elements of an array. */
+#define QX_TEST_COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/**
+ * @brief Frames of the block that starts at @p pos when @p total frames
+ *        are split into blocks of @p block frames.
+ */
+static inline size_t qx_test_block_frames(size_t total, size_t pos, size_t block)
+{
+        return total - pos < block ? total - pos : block;
+}
+
+#endif // QX_TEST_H
@@ -0,0 +1,251 @@
+/**
+ * @file test_crossfader.c
+ * @brief Crossfader blocks, start offsets and reversals against qx_crossfader_process().
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * A linear crossfade of 5 ms at 48 kHz started with an offset must keep
+ * playing input a up to the offset and then move the position by 1/240
+ * per frame, whether the offset is inside the first block or several
+ * blocks later. A fade reversed while running must turn around without
+ * a jump: 0.3 -> 0.4 -> 0.5 -> 0.4 -> 0.3. The equal-power gains must
+ * keep ga^2 + gb^2 = 1 over a whole fade. qx_crossfader_process_block()
+ * must match qx_crossfader_process() called for every sample to float
+ * rounding, for every curve and block size, over a script of starts,
+ * offsets, replaced starts, reversals and jumps.
+ */
+
+#include "qx_crossfader.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <string.h>
+
+#define FRAMES 1000
+#define FADE_FRAMES 240
+#define TOLERANCE 1e-5f
+
+static float ones[FRAMES];
+static float zeros[FRAMES];
+static float input_a[FRAMES];
+static float input_b[FRAMES];
+
+static const size_t blocks[] = {1, 5, 64, 100, 256, FRAMES};
+
+/*
+ * A start or a jump issued before frame `frame`. Jumps have a position
+ * of 0 or more, starts a negative one.
+ */
+struct event {
+        size_t frame;
+        bool to_b;
+        size_t offset;
+        float position;
+};
+
+static const struct event script[] = {
+        {0, true, 37, -1.0f},
+        {150, false, 90, -1.0f},  // reverses at 240, at position 0.85
+        {400, true, 0, -1.0f},
+        {420, false, 500, -1.0f}, // replaced before it starts
+        {430, true, 10, -1.0f},
+        {700, false, 0, 0.5f},
+        {710, false, 0, -1.0f},
+};
+
+static void xf_setup(struct qx_crossfader* xf, enum qx_fader_curve curve)
+{
+        qx_crossfader_init(xf, 5.0f, 48000.0f);
+        qx_crossfader_set_curve(xf, curve);
+}
+
+/*
+ * Run frames [pos, pos + n) with process_block in blocks of `block`
+ * frames, or per sample when `block` is 0.
+ */
+static void run(struct qx_crossfader* xf, const float* a, const float* b, float* out,
+                size_t pos, size_t n, size_t block)
+{
+        if (block == 0) {
+                for (size_t i = pos; i < pos + n; i++)
+                        out[i] = qx_crossfader_process(xf, a[i], b[i]);
+                return;
+        }
+        for (size_t i = 0; i < n; i += block) {
+                size_t m = qx_test_block_frames(n, i, block);
+                qx_crossfader_process_block(xf, a + pos + i, b + pos + i, out + pos + i, m);
+        }
+}
+
+/*
+ * Gains of inputs a and b over FRAMES frames after start(true, offset)
+ * from position 0.
+ */
+static void offset_gains(size_t offset, size_t block, float* ga, float* gb)
+{
+        struct qx_crossfader xf;
+        xf_setup(&xf, QX_FADER_CURVE_LINEAR);
+        qx_crossfader_start(&xf, true, offset);
+        run(&xf, ones, zeros, ga, 0, FRAMES, block);
+
+        xf_setup(&xf, QX_FADER_CURVE_LINEAR);
+        qx_crossfader_start(&xf, true, offset);
+        run(&xf, zeros, ones, gb, 0, FRAMES, block);
+}
+
+static void check_offset(size_t offset, size_t block)
+{
+        float ga[FRAMES], gb[FRAMES];
+        offset_gains(offset, block, ga, gb);
+
+        for (size_t i = 0; i < FRAMES; i++) {
+                float x = i < offset ? 0.0f : fminf((float)(i - offset + 1) / FADE_FRAMES, 1.0f);
+                if (!(fabsf(gb[i] - x) <= TOLERANCE && fabsf(ga[i] - (1.0f - x)) <= TOLERANCE)) {
+                        QX_CHECK(false, "offset %zu block %zu: gains %g, %g instead of %g, %g at %zu",
+                                 offset, block, ga[i], gb[i], 1.0f - x, x, i);
+                        return;
+                }
+        }
+}
+
+/*
+ * From 0.3 towards b for 24 frames, then a block of 48 that reverses at
+ * its middle, then 24 frames back to 0.3.
+ */
+static void check_reversal(size_t block)
+{
+        struct qx_crossfader xf;
+        xf_setup(&xf, QX_FADER_CURVE_LINEAR);
+        qx_crossfader_set_position(&xf, 0.3f);
+
+        float pos[96];
+        qx_crossfader_start(&xf, true, 0);
+        run(&xf, zeros, ones, pos, 0, 24, block);
+        QX_CHECK(fabsf(qx_crossfader_position(&xf) - 0.4f) <= TOLERANCE,
+                 "reversal block %zu: position %g instead of 0.4", block, qx_crossfader_position(&xf));
+
+        qx_crossfader_start(&xf, false, 24);
+        run(&xf, zeros, ones, pos, 24, 48, block);
+        QX_CHECK(fabsf(pos[47] - 0.5f) <= TOLERANCE,
+                 "reversal block %zu: turned at %g instead of 0.5", block, pos[47]);
+        QX_CHECK(fabsf(qx_crossfader_position(&xf) - 0.4f) <= TOLERANCE,
+                 "reversal block %zu: position %g instead of 0.4", block, qx_crossfader_position(&xf));
+
+        run(&xf, zeros, ones, pos, 72, 24, block);
+        QX_CHECK(fabsf(qx_crossfader_position(&xf) - 0.3f) <= TOLERANCE,
+                 "reversal block %zu: position %g instead of 0.3", block, qx_crossfader_position(&xf));
+
+        float prev = 0.3f;
+        for (size_t i = 0; i < 96; i++) {
+                float expected = prev + (i < 48 ? 1.0f : -1.0f) / FADE_FRAMES;
+                QX_CHECK(fabsf(pos[i] - expected) <= TOLERANCE,
+                         "reversal block %zu: %g instead of %g at %zu", block, pos[i], expected, i);
+                prev = pos[i];
+        }
+}
+
+static void check_equal_power(size_t block)
+{
+        struct qx_crossfader xa, xb;
+        xf_setup(&xa, QX_FADER_CURVE_EQUAL_POWER);
+        xf_setup(&xb, QX_FADER_CURVE_EQUAL_POWER);
+        qx_crossfader_start(&xa, true, 3);
+        qx_crossfader_start(&xb, true, 3);
+
+        float ga[FRAMES], gb[FRAMES];
+        run(&xa, ones, zeros, ga, 0, FRAMES, block);
+        run(&xb, zeros, ones, gb, 0, FRAMES, block);
+        for (size_t i = 0; i < FRAMES; i++) {
+                float power = ga[i] * ga[i] + gb[i] * gb[i];
+                QX_CHECK(fabsf(power - 1.0f) <= 1e-4f, "equal power block %zu: power %g at %zu", block, power, i);
+        }
+        QX_CHECK(ga[2] == 1.0f && gb[2] == 0.0f && ga[FRAMES - 1] == 0.0f && gb[FRAMES - 1] == 1.0f,
+                 "equal power block %zu: gains %g, %g before and %g, %g after the fade",
+                 block, ga[2], gb[2], ga[FRAMES - 1], gb[FRAMES - 1]);
+}
+
+static void check_block(enum qx_fader_curve curve, size_t block)
+{
+        struct qx_crossfader ref, blk;
+        xf_setup(&ref, curve);
+        xf_setup(&blk, curve);
+
+        float expected[FRAMES], out[FRAMES];
+        size_t pos = 0;
+        for (size_t e = 0; e <= QX_TEST_COUNT(script); e++) {
+                size_t end = e < QX_TEST_COUNT(script) ? script[e].frame : FRAMES;
+                run(&ref, input_a, input_b, expected, pos, end - pos, 0);
+                run(&blk, input_a, input_b, out, pos, end - pos, block);
+                QX_CHECK(fabsf(qx_crossfader_position(&blk) - qx_crossfader_position(&ref)) <= TOLERANCE,
+                         "curve %d block %zu: position %g instead of %g at %zu", curve, block,
+                         qx_crossfader_position(&blk), qx_crossfader_position(&ref), end);
+                pos = end;
+                if (e == QX_TEST_COUNT(script))
+                        break;
+
+                const struct event* ev = &script[e];
+                if (ev->position >= 0.0f) {
+                        qx_crossfader_set_position(&ref, ev->position);
+                        qx_crossfader_set_position(&blk, ev->position);
+                } else {
+                        qx_crossfader_start(&ref, ev->to_b, ev->offset);
+                        qx_crossfader_start(&blk, ev->to_b, ev->offset);
+                }
+        }
+
+        for (size_t i = 0; i < FRAMES; i++) {
+                if (!(fabsf(out[i] - expected[i]) <= TOLERANCE)) {
+                        QX_CHECK(false, "curve %d block %zu: %g instead of %g at %zu",
+                                 curve, block, out[i], expected[i], i);
+                        return;
+                }
+        }
+}
+
+int main(void)
+{
+        for (size_t i = 0; i < FRAMES; i++) {
+                ones[i] = 1.0f;
+                input_a[i] = sinf(0.05f * (float)i);
+                input_b[i] = 0.25f + cosf(0.031f * (float)i);
+        }
+
+        static const size_t offsets[] = {0, 1, 17, 63, 64, 100, 255, 300, 700};
+        for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                for (size_t o = 0; o < QX_TEST_COUNT(offsets); o++)
+                        check_offset(offsets[o], blocks[b]);
+                check_reversal(blocks[b]);
+                check_equal_power(blocks[b]);
+        }
+        check_offset(100, 0);
+        check_reversal(0);
+        check_equal_power(0);
+
+        for (int curve = 0; curve <= QX_FADER_CURVE_RAISED_COSINE; curve++) {
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                        check_block((enum qx_fader_curve)curve, blocks[b]);
+        }
+
+        return qx_test_result("test_crossfader");
+}
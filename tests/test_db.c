@@ -0,0 +1,131 @@
+/**
+ * @file test_db.c
+ * @brief Error bounds of the fast decibel conversions on every instruction set.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Checks the documented maximum errors of qx_db_to_val_fast() (1.4e-5 dB)
+ * and qx_val_to_db_fast() (2.2e-5 dB) over [-200, +60] dB against double
+ * precision, for the scalar functions and for the array conversions of
+ * every kernel table the CPU supports. NaN must come out as NaN.
+ */
+
+#include "qx_dsp.h"
+#include "qx_math.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define DB_MIN -200.0
+#define DB_MAX 60.0
+#define DB_STEP 0.001
+#define DB_TO_VAL_MAX_ERROR 1.4e-5
+#define VAL_TO_DB_MAX_ERROR 2.2e-5
+
+static double db_to_val_error(float db, float val)
+{
+        return fabs(20.0 * log10((double)val) - (double)db);
+}
+
+static double val_to_db_error(float val, float db)
+{
+        return fabs((double)db - 20.0 * log10((double)val));
+}
+
+static void check_arrays(const struct qx_dsp_kernels* k,
+                         const float* db,
+                         const float* val,
+                         float* out,
+                         size_t n)
+{
+        const char* name = qx_dsp_isa_name(k->isa);
+
+        double worst = 0.0;
+        k->db_to_val_array(db, out, n);
+        for (size_t i = 0; i < n; i++) {
+                double err = db_to_val_error(db[i], out[i]);
+                worst = err > worst ? err : worst;
+        }
+        QX_CHECK(worst <= DB_TO_VAL_MAX_ERROR, "%s db_to_val_array: error %g dB", name, worst);
+
+        worst = 0.0;
+        k->val_to_db_array(val, out, n);
+        for (size_t i = 0; i < n; i++) {
+                double err = val_to_db_error(val[i], out[i]);
+                worst = err > worst ? err : worst;
+        }
+        QX_CHECK(worst <= VAL_TO_DB_MAX_ERROR, "%s val_to_db_array: error %g dB", name, worst);
+
+        // NaN in every lane position of the vector and the scalar tail
+        float in[19];
+        for (size_t i = 0; i < 19; i++)
+                in[i] = (i % 3 == 0) ? NAN : -6.0f;
+        k->db_to_val_array(in, out, 19);
+        for (size_t i = 0; i < 19; i++) {
+                if (i % 3 == 0)
+                        QX_CHECK(isnan(out[i]), "%s db_to_val_array: NaN gives %g at %zu", name, out[i], i);
+                else
+                        QX_CHECK(db_to_val_error(in[i], out[i]) <= DB_TO_VAL_MAX_ERROR,
+                                 "%s db_to_val_array: %g next to NaN", name, out[i]);
+        }
+}
+
+int main(void)
+{
+        size_t n = (size_t)((DB_MAX - DB_MIN) / DB_STEP) + 1;
+        float* db = (float*)malloc(n * sizeof(float));
+        float* val = (float*)malloc(n * sizeof(float));
+        float* out = (float*)malloc(n * sizeof(float));
+        if (!db || !val || !out)
+                return 1;
+
+        for (size_t i = 0; i < n; i++) {
+                db[i] = (float)(DB_MIN + (double)i * DB_STEP);
+                val[i] = (float)pow(10.0, (double)db[i] / 20.0);
+        }
+
+        double worst_to_val = 0.0;
+        double worst_to_db = 0.0;
+        for (size_t i = 0; i < n; i++) {
+                double err = db_to_val_error(db[i], qx_db_to_val_fast(db[i]));
+                worst_to_val = err > worst_to_val ? err : worst_to_val;
+                err = val_to_db_error(val[i], qx_val_to_db_fast(val[i]));
+                worst_to_db = err > worst_to_db ? err : worst_to_db;
+        }
+        QX_CHECK(worst_to_val <= DB_TO_VAL_MAX_ERROR, "qx_db_to_val_fast: error %g dB", worst_to_val);
+        QX_CHECK(worst_to_db <= VAL_TO_DB_MAX_ERROR, "qx_val_to_db_fast: error %g dB", worst_to_db);
+        QX_CHECK(isnan(qx_fast_exp2f(NAN)), "qx_fast_exp2f: NaN gives %g", qx_fast_exp2f(NAN));
+        QX_CHECK(isnan(qx_db_to_val_fast(NAN)), "qx_db_to_val_fast: NaN gives %g", qx_db_to_val_fast(NAN));
+
+        for (int isa = 0; isa < QX_DSP_ISA_COUNT; isa++) {
+                if (qx_dsp_set_isa((enum qx_dsp_isa)isa))
+                        check_arrays(qx_dsp(), db, val, out, n);
+        }
+
+        free(db);
+        free(val);
+        free(out);
+        return qx_test_result("test_db");
+}
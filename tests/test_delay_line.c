@@ -0,0 +1,224 @@
+/**
+ * @file test_delay_line.c
+ * @brief Block delay line reads against per-sample push and tap.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * A delay of 0 must return the current input, an integer delay d the
+ * input of d frames before and a fractional delay the linear mix of the
+ * two samples around it. qx_delay_line_read_fixed() must copy the
+ * samples of an integer delay exactly. The ring must be the smallest power of two that
+ * holds the delay, a block and the guard samples, and init must fail
+ * when that is more than QX_DELAY_LINE_MAX_CAPACITY.
+ *
+ * A reference line is fed with qx_delay_line_push() and read with
+ * qx_delay_line_tap() or qx_delay_line_tap_hermite() after every sample;
+ * the block line writes a block, reads it with the block functions and
+ * advances. Both must give the same output for modulated and fixed
+ * delays over many blocks, so the reads cross the wrap of the ring.
+ */
+
+#include "qx_delay_line.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#define MAX_DELAY 300
+#define MAX_FRAMES 128
+#define FRAMES 5000
+#define TOLERANCE 4e-6f
+
+enum reader {
+        READER_PROCESS,
+        READER_HERMITE,
+        READER_FIXED,
+        READER_FIXED_INTEGER,
+        READER_COUNT
+};
+
+static const char* const reader_names[] = {"process", "read_hermite", "read_fixed", "read_fixed integer"};
+
+static float input[FRAMES];
+static float delays[FRAMES];
+
+static float delay_at(enum reader r, size_t i)
+{
+        switch (r) {
+        case READER_FIXED:
+                return 123.375f;
+        case READER_FIXED_INTEGER:
+                return (float)MAX_DELAY;
+        default:
+                return delays[i];
+        }
+}
+
+static float input_at(long i)
+{
+        return i >= 0 ? input[i] : 0.0f;
+}
+
+static void check_delay(float delay, size_t block, bool fixed)
+{
+        struct qx_delay_line line;
+        if (!qx_delay_line_init(&line, MAX_DELAY, MAX_FRAMES)) {
+                QX_CHECK(false, "init failed");
+                return;
+        }
+
+        float d[MAX_FRAMES];
+        float out[MAX_FRAMES];
+        for (size_t j = 0; j < MAX_FRAMES; j++)
+                d[j] = delay;
+
+        const long whole = (long)delay;
+        const float frac = delay - (float)whole;
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                if (fixed) {
+                        qx_delay_line_write(&line, input + pos, n);
+                        qx_delay_line_read_fixed(&line, delay, out, n);
+                        qx_delay_line_advance(&line, n);
+                } else {
+                        qx_delay_line_process(&line, input + pos, d, out, n);
+                }
+
+                for (size_t j = 0; j < n; j++) {
+                        long i = (long)(pos + j);
+                        float expected = (1.0f - frac) * input_at(i - whole) + frac * input_at(i - whole - 1);
+                        bool ok = fixed && frac == 0.0f ? out[j] == expected : fabsf(out[j] - expected) <= TOLERANCE;
+                        if (!ok) {
+                                QX_CHECK(false, "%s delay %g block %zu: %.9g instead of %.9g at %ld",
+                                         fixed ? "read_fixed" : "process", delay, block, out[j], expected, i);
+                                pos = FRAMES;
+                                break;
+                        }
+                }
+        }
+
+        qx_delay_line_free(&line);
+}
+
+static void check_capacity(void)
+{
+        struct qx_delay_line line;
+        QX_CHECK(qx_delay_line_init(&line, MAX_DELAY, MAX_FRAMES) && line.capacity == 512 && line.mask == 511,
+                 "capacity %u for %d + %d frames", line.capacity, MAX_DELAY, MAX_FRAMES);
+        qx_delay_line_free(&line);
+
+        QX_CHECK(qx_delay_line_init(&line, 508, 0) && line.capacity == 512,
+                 "capacity %u for 508 + 4 frames", line.capacity);
+        qx_delay_line_free(&line);
+
+        QX_CHECK(qx_delay_line_init(&line, 509, 0) && line.capacity == 1024,
+                 "capacity %u for 509 + 4 frames", line.capacity);
+        qx_delay_line_free(&line);
+
+        static const size_t too_large[][2] = {
+                {QX_DELAY_LINE_MAX_CAPACITY, 0},
+                {QX_DELAY_LINE_MAX_CAPACITY - QX_DELAY_LINE_GUARD, 1},
+                {1, QX_DELAY_LINE_MAX_CAPACITY - QX_DELAY_LINE_GUARD},
+                {SIZE_MAX, 64},
+                {64, SIZE_MAX},
+        };
+        for (size_t t = 0; t < QX_TEST_COUNT(too_large); t++) {
+                bool ok = qx_delay_line_init(&line, too_large[t][0], too_large[t][1]);
+                QX_CHECK(!ok && !line.data && line.capacity == 0,
+                         "init of %zu + %zu frames did not fail", too_large[t][0], too_large[t][1]);
+                if (ok)
+                        qx_delay_line_free(&line);
+        }
+}
+
+static void check_reader(enum reader r, size_t block)
+{
+        struct qx_delay_line ref, blk;
+        if (!qx_delay_line_init(&ref, MAX_DELAY, MAX_FRAMES) || !qx_delay_line_init(&blk, MAX_DELAY, MAX_FRAMES))
+                return;
+
+        float out[MAX_FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                switch (r) {
+                case READER_PROCESS:
+                        qx_delay_line_process(&blk, input + pos, delays + pos, out, n);
+                        break;
+                case READER_HERMITE:
+                        qx_delay_line_write(&blk, input + pos, n);
+                        qx_delay_line_read_hermite(&blk, delays + pos, out, n);
+                        qx_delay_line_advance(&blk, n);
+                        break;
+                default:
+                        qx_delay_line_write(&blk, input + pos, n);
+                        qx_delay_line_read_fixed(&blk, delay_at(r, pos), out, n);
+                        qx_delay_line_advance(&blk, n);
+                        break;
+                }
+
+                for (size_t j = 0; j < n; j++) {
+                        size_t i = pos + j;
+                        qx_delay_line_push(&ref, input[i]);
+                        float expected = r == READER_HERMITE ? qx_delay_line_tap_hermite(&ref, delays[i])
+                                                             : qx_delay_line_tap(&ref, delay_at(r, i));
+                        if (!(fabsf(out[j] - expected) <= TOLERANCE)) {
+                                QX_CHECK(false, "%s block %zu: %.9g instead of %.9g at %zu",
+                                         reader_names[r], block, out[j], expected, i);
+                                pos = FRAMES;
+                                break;
+                        }
+                }
+        }
+
+        qx_delay_line_free(&ref);
+        qx_delay_line_free(&blk);
+}
+
+int main(void)
+{
+        for (size_t i = 0; i < FRAMES; i++) {
+                input[i] = sinf(0.013f * (float)i) + 0.25f * sinf(0.71f * (float)i);
+                // Chorus-like modulation over [1, MAX_DELAY], with integer delays mixed in
+                delays[i] = 1.0f + (MAX_DELAY - 1) * 0.5f * (1.0f + sinf(0.002f * (float)i));
+                if (i % 17 == 0)
+                        delays[i] = floorf(delays[i]);
+        }
+
+        static const size_t blocks[] = {1, 7, 64, MAX_FRAMES};
+        static const float fixed[] = {0.0f, 1.0f, 17.0f, 17.25f, 299.5f, MAX_DELAY};
+        check_capacity();
+        for (size_t d = 0; d < QX_TEST_COUNT(fixed); d++) {
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                        check_delay(fixed[d], blocks[b], false);
+                        check_delay(fixed[d], blocks[b], true);
+                }
+        }
+
+        for (int r = 0; r < READER_COUNT; r++) {
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                        check_reader((enum reader)r, blocks[b]);
+        }
+
+        return qx_test_result("test_delay_line");
+}
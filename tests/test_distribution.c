@@ -0,0 +1,219 @@
+/**
+ * @file test_distribution.c
+ * @brief Distribution block fills against the single-value samplers.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * One million values of each sampler from a fixed seed must have the
+ * moments of their distribution: normal mean, standard deviation and the
+ * fractions beyond 3 and 4 standard deviations, exponential mean 1/rate
+ * and variance 1/rate^2, triangular mean, standard deviation and bounds,
+ * and a Poisson table mean and variance lambda on integer values. The
+ * limits are about five standard errors.
+ *
+ * The normal, triangular and inverse CDF fills must give exactly the
+ * values of repeated single calls, the exponential fill the same values
+ * to float rounding of the vector logarithm. Every fill must leave the
+ * randomizer in the state of the single calls.
+ */
+
+#include "qx_distribution.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VALUES 2000
+#define STAT_VALUES 1000000
+#define EXPONENTIAL_TOLERANCE 1e-5f
+
+static const size_t blocks[] = {1, 7, 100, 255, 256, 257, VALUES};
+
+enum sampler {
+        SAMPLER_NORMAL,
+        SAMPLER_EXPONENTIAL,
+        SAMPLER_TRIANGULAR,
+        SAMPLER_ICDF,
+        SAMPLER_COUNT
+};
+
+static const char* const sampler_names[] = {"normal", "exponential", "triangular", "icdf"};
+
+static struct qx_icdf_table poisson;
+
+static float sample(enum sampler s, struct qx_randomizer* rand)
+{
+        switch (s) {
+        case SAMPLER_NORMAL:
+                return qx_dist_normal(rand, 1.5f, 0.25f);
+        case SAMPLER_EXPONENTIAL:
+                return qx_dist_exponential(rand, 2.0f);
+        case SAMPLER_TRIANGULAR:
+                return qx_dist_triangular(rand, -1.0f, 3.0f);
+        default:
+                return qx_dist_icdf(rand, &poisson);
+        }
+}
+
+static void fill(enum sampler s, struct qx_randomizer* rand, float* out, size_t n)
+{
+        switch (s) {
+        case SAMPLER_NORMAL:
+                qx_dist_normal_fill(rand, 1.5f, 0.25f, out, n);
+                break;
+        case SAMPLER_EXPONENTIAL:
+                qx_dist_exponential_fill(rand, 2.0f, out, n);
+                break;
+        case SAMPLER_TRIANGULAR:
+                qx_dist_triangular_fill(rand, -1.0f, 3.0f, out, n);
+                break;
+        default:
+                qx_dist_icdf_fill(rand, &poisson, out, n);
+                break;
+        }
+}
+
+static void check_fill(enum sampler s, enum qx_random_engine_type type, size_t block)
+{
+        struct qx_randomizer ref, blk;
+        struct qx_random_engine ref_engine, blk_engine;
+        qx_randomizer_init_seed(&ref, &ref_engine, type, 808u, 0.0f, 1.0f, 1e-6f);
+        qx_randomizer_init_seed(&blk, &blk_engine, type, 808u, 0.0f, 1.0f, 1e-6f);
+
+        float out[VALUES];
+        for (size_t pos = 0; pos < VALUES; pos += block) {
+                size_t n = qx_test_block_frames(VALUES, pos, block);
+                fill(s, &blk, out + pos, n);
+        }
+        for (size_t i = 0; i < VALUES; i++) {
+                float expected = sample(s, &ref);
+                bool ok = s == SAMPLER_EXPONENTIAL
+                          ? fabsf(out[i] - expected) <= EXPONENTIAL_TOLERANCE * fmaxf(fabsf(expected), 1.0f)
+                          : memcmp(&out[i], &expected, sizeof(float)) == 0;
+                if (!ok) {
+                        QX_CHECK(false, "%s engine %d block %zu: %.9g instead of %.9g at %zu",
+                                 sampler_names[s], type, block, out[i], expected, i);
+                        return;
+                }
+        }
+        QX_CHECK(qx_randomizer_next_u32(&blk) == qx_randomizer_next_u32(&ref),
+                 "%s engine %d block %zu: different state after the fill", sampler_names[s], type, block);
+}
+
+struct moments {
+        double mean;
+        double stddev;
+        float min;
+        float max;
+};
+
+static struct moments moments_of(const float* x, size_t n)
+{
+        struct moments m = {0.0, 0.0, x[0], x[0]};
+        for (size_t i = 0; i < n; i++) {
+                m.mean += x[i];
+                m.min = fminf(m.min, x[i]);
+                m.max = fmaxf(m.max, x[i]);
+        }
+        m.mean /= (double)n;
+        for (size_t i = 0; i < n; i++)
+                m.stddev += (x[i] - m.mean) * (x[i] - m.mean);
+        m.stddev = sqrt(m.stddev / (double)(n - 1));
+        return m;
+}
+
+static void check_statistics(enum qx_random_engine_type type)
+{
+        float* x = (float*)malloc(STAT_VALUES * sizeof(float));
+        if (!x) {
+                QX_CHECK(false, "statistics: out of memory");
+                return;
+        }
+
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        qx_randomizer_init_seed(&rand, &engine, type, 1234u, 0.0f, 1.0f, 1e-6f);
+
+        qx_dist_normal_fill(&rand, 1.5f, 0.25f, x, STAT_VALUES);
+        struct moments m = moments_of(x, STAT_VALUES);
+        size_t beyond3 = 0, beyond4 = 0;
+        for (size_t i = 0; i < STAT_VALUES; i++) {
+                beyond3 += fabsf(x[i] - 1.5f) > 3.0f * 0.25f;
+                beyond4 += fabsf(x[i] - 1.5f) > 4.0f * 0.25f;
+        }
+        QX_CHECK(fabs(m.mean - 1.5) < 1.5e-3, "normal engine %d: mean %g instead of 1.5", type, m.mean);
+        QX_CHECK(fabs(m.stddev - 0.25) < 1e-3, "normal engine %d: stddev %g instead of 0.25", type, m.stddev);
+        // 2700 and 63 expected
+        QX_CHECK(beyond3 > 2440 && beyond3 < 2960, "normal engine %d: %zu values beyond 3 stddev instead of 2700",
+                 type, beyond3);
+        QX_CHECK(beyond4 > 25 && beyond4 < 105, "normal engine %d: %zu values beyond 4 stddev instead of 63",
+                 type, beyond4);
+
+        qx_dist_exponential_fill(&rand, 2.0f, x, STAT_VALUES);
+        m = moments_of(x, STAT_VALUES);
+        QX_CHECK(fabs(m.mean - 0.5) < 2.5e-3, "exponential engine %d: mean %g instead of 0.5", type, m.mean);
+        QX_CHECK(fabs(m.stddev - 0.5) < 5e-3, "exponential engine %d: stddev %g instead of 0.5", type, m.stddev);
+        QX_CHECK(m.min >= 0.0f, "exponential engine %d: negative value %g", type, m.min);
+
+        qx_dist_triangular_fill(&rand, -1.0f, 3.0f, x, STAT_VALUES);
+        m = moments_of(x, STAT_VALUES);
+        QX_CHECK(fabs(m.mean - 1.0) < 4e-3, "triangular engine %d: mean %g instead of 1", type, m.mean);
+        QX_CHECK(fabs(m.stddev - 4.0 / sqrt(24.0)) < 3e-3, "triangular engine %d: stddev %g instead of %g",
+                 type, m.stddev, 4.0 / sqrt(24.0));
+        QX_CHECK(m.min >= -1.0f && m.max <= 3.0f, "triangular engine %d: values in [%g, %g] instead of [-1, 3]",
+                 type, m.min, m.max);
+
+        qx_dist_icdf_fill(&rand, &poisson, x, STAT_VALUES);
+        m = moments_of(x, STAT_VALUES);
+        size_t fractional = 0;
+        for (size_t i = 0; i < STAT_VALUES; i++)
+                fractional += x[i] != floorf(x[i]) || x[i] < 0.0f;
+        QX_CHECK(fabs(m.mean - 3.5) < 0.02, "poisson engine %d: mean %g instead of 3.5", type, m.mean);
+        QX_CHECK(fabs(m.stddev * m.stddev - 3.5) < 0.05, "poisson engine %d: variance %g instead of 3.5",
+                 type, m.stddev * m.stddev);
+        QX_CHECK(fractional == 0, "poisson engine %d: %zu values not non-negative integers", type, fractional);
+
+        free(x);
+}
+
+int main(void)
+{
+        if (!qx_icdf_table_init_poisson(&poisson, 3.5f, 10))
+                return 1;
+
+        static const enum qx_random_engine_type engines[] = {QX_RANDOM_ENGINE_LCG, QX_RANDOM_ENGINE_PHILOX};
+        for (size_t e = 0; e < QX_TEST_COUNT(engines); e++)
+                check_statistics(engines[e]);
+
+        for (int s = 0; s < SAMPLER_COUNT; s++) {
+                for (size_t e = 0; e < QX_TEST_COUNT(engines); e++) {
+                        for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                                check_fill((enum sampler)s, engines[e], blocks[b]);
+                }
+        }
+
+        qx_icdf_table_free(&poisson);
+        return qx_test_result("test_distribution");
+}
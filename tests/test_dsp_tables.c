@@ -0,0 +1,756 @@
+/**
+ * @file test_dsp_tables.c
+ * @brief Every kernel table against the scalar table.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Runs every member of the kernel table of each instruction set the CPU
+ * supports on the same input as the scalar table and compares the
+ * outputs. The random number, distribution and noise fills, the
+ * denormalize, clamp and wrap arrays are documented to give the same
+ * values on every instruction set and must match bit for bit. The fast
+ * log/exp conversions are compared within their error bounds, the other
+ * floating point kernels within a few float ulps, since the vector code
+ * may round sums and products in a different order.
+ */
+
+#include "qx_crossfader.h"
+#include "qx_delay_line.h"
+#include "qx_distribution.h"
+#include "qx_dsp.h"
+#include "qx_fader.h"
+#include "qx_interp.h"
+#include "qx_math.h"
+#include "qx_noise.h"
+#include "qx_random_engine.h"
+#include "qx_randomizer.h"
+#include "qx_smoother.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Not a multiple of any vector width, so every scalar tail runs */
+#define FRAMES 1003
+#define OUT_MAX (8 * FRAMES)
+#define RING_SIZE 1024
+
+/** Tolerance of a kernel: |a - b| <= abs + rel * |b|, bit-exact if both are 0. */
+struct tolerance {
+        double abs;
+        double rel;
+};
+
+static const struct tolerance exact = {0.0, 0.0};
+static const struct tolerance ulps = {1e-6, 1e-5};
+static const struct tolerance db_to_val = {0.0, 4e-6};   // 2 x 1.4e-5 dB
+static const struct tolerance val_to_db = {5e-5, 0.0};   // 2 x 2.2e-5 dB
+
+struct kernel_case {
+        const char* name;
+        size_t (*run)(const struct qx_dsp_kernels* k, float* out);
+        const struct tolerance* tol;
+};
+
+static float signal_a[OUT_MAX];
+static float signal_b[OUT_MAX];
+static float gains[OUT_MAX];
+static float ring[RING_SIZE];
+static float ring_index[FRAMES];
+static float delays[FRAMES];
+
+static void fill_uniform(float* buf, size_t n, float lo, float hi, uint32_t seed)
+{
+        for (size_t i = 0; i < n; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                buf[i] = lo + (hi - lo) * (float)(seed >> 8) * (1.0f / 16777216.0f);
+        }
+}
+
+static size_t run_simd_ramp_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_ramp_fill(out, FRAMES, 0.1f, 0.0007f, 0.0f, 1.0f);
+        return FRAMES;
+}
+
+static size_t run_simd_ramp_mul(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_ramp_mul(signal_a, out, FRAMES, 0.9f, -0.0011f, 0.0f, 1.0f);
+        return FRAMES;
+}
+
+static size_t run_simd_mul(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_mul(signal_a, signal_b, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_simd_scale(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_scale(signal_a, out, FRAMES, 0.7f);
+        return FRAMES;
+}
+
+static size_t run_simd_mix(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_mix(signal_a, gains, signal_b, gains + FRAMES, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_simd_mix_gain(const struct qx_dsp_kernels* k, float* out)
+{
+        k->simd_mix_gain(signal_a, signal_b, out, FRAMES, 0.3f, 0.6f);
+        k->simd_mix_gain(signal_a, signal_b, out + FRAMES, FRAMES, 0.0f, 0.6f);
+        return 2 * FRAMES;
+}
+
+/** Fader of the given curve in the middle of a 10 ms fade-in. */
+static void fader_setup(struct qx_fader* fader, enum qx_fader_curve curve, bool enabled)
+{
+        qx_fader_init(fader, 10.0f, 48000.0f);
+        qx_fader_set_curve(fader, curve);
+        qx_fader_set_retrigger(fader, true);
+        fader->fade = 0.3f;
+        qx_fader_enable(fader, enabled);
+}
+
+static size_t run_fader_process_block(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int c = 0; c <= QX_FADER_CURVE_RAISED_COSINE; c++) {
+                struct qx_fader fader;
+                fader_setup(&fader, (enum qx_fader_curve)c, true);
+                memcpy(out + c * FRAMES, signal_a, FRAMES * sizeof(float));
+                k->fader_process_block(&fader, out + c * FRAMES, FRAMES);
+        }
+        return 5 * FRAMES;
+}
+
+static size_t run_fader_process_block_out(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int c = 0; c <= QX_FADER_CURVE_RAISED_COSINE; c++) {
+                struct qx_fader fader;
+                fader_setup(&fader, (enum qx_fader_curve)c, false);
+                k->fader_process_block_out(&fader, signal_a, out + c * FRAMES, FRAMES);
+        }
+        return 5 * FRAMES;
+}
+
+static size_t run_fader_process_block_end(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_EQUAL_POWER, false);
+        memcpy(out, signal_a, FRAMES * sizeof(float));
+        out[FRAMES] = (float)k->fader_process_block_end(&fader, out, FRAMES);
+        out[FRAMES + 1] = fader.fade;
+        return FRAMES + 2;
+}
+
+static size_t run_fader_process_block_end_out(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_EXPONENTIAL, true);
+        out[FRAMES] = (float)k->fader_process_block_end_out(&fader, signal_a, out, FRAMES);
+        out[FRAMES + 1] = fader.fade;
+        return FRAMES + 2;
+}
+
+static size_t run_fader_process_interleaved(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_LOGARITHMIC, true);
+        memcpy(out, signal_a, 3 * FRAMES * sizeof(float));
+        k->fader_process_interleaved(&fader, out, FRAMES, 3);
+        return 3 * FRAMES;
+}
+
+static size_t run_fader_process_interleaved_out(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_RAISED_COSINE, false);
+        k->fader_process_interleaved_out(&fader, signal_a, out, FRAMES, 2);
+        return 2 * FRAMES;
+}
+
+/** Bank of 37 faders with different positions and directions. */
+static bool bank_setup(struct qx_fader_bank* bank)
+{
+        if (!qx_fader_bank_init(bank, 37, 5.0f, 48000.0f))
+                return false;
+        qx_fader_bank_set_retrigger(bank, true);
+        qx_fader_bank_set_curve(bank, QX_FADER_CURVE_EQUAL_POWER);
+        for (size_t i = 0; i < bank->count; i++) {
+                bank->fade[i] = (float)i / (float)bank->count;
+                if (i % 3 == 0)
+                        qx_fader_bank_enable_time(bank, i, i % 2 == 0, 1.0f + (float)i);
+                else
+                        qx_fader_bank_enable(bank, i, i % 2 == 0);
+        }
+        return true;
+}
+
+static size_t bank_output(const struct qx_fader_bank* bank, float* out)
+{
+        memcpy(out, bank->fade, bank->count * sizeof(float));
+        memcpy(out + bank->count, bank->step, bank->count * sizeof(float));
+        memcpy(out + 2 * bank->count, bank->base_step, bank->count * sizeof(float));
+        return 3 * bank->count;
+}
+
+static size_t run_fader_bank_advance(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader_bank bank;
+        if (!bank_setup(&bank))
+                return 0;
+        size_t n = 0;
+        for (size_t frames = 1; frames < FRAMES; frames *= 3) {
+                k->fader_bank_advance(&bank, frames);
+                n += bank_output(&bank, out + n);
+        }
+        qx_fader_bank_free(&bank);
+        return n;
+}
+
+static size_t run_fader_bank_set_time(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader_bank bank;
+        if (!bank_setup(&bank))
+                return 0;
+        k->fader_bank_set_time(&bank, 7.0f);
+        size_t n = bank_output(&bank, out);
+        k->fader_bank_set_time(&bank, 0.0f);
+        n += bank_output(&bank, out + n);
+        qx_fader_bank_free(&bank);
+        return n;
+}
+
+static size_t run_fader_bank_set_sample_rate(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader_bank bank;
+        if (!bank_setup(&bank))
+                return 0;
+        k->fader_bank_set_sample_rate(&bank, 44100.0f);
+        size_t n = bank_output(&bank, out);
+        k->fader_bank_set_sample_rate(&bank, 96000.0f);
+        n += bank_output(&bank, out + n);
+        qx_fader_bank_free(&bank);
+        return n;
+}
+
+static size_t run_fader_bank_process(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_fader_bank bank;
+        if (!bank_setup(&bank))
+                return 0;
+        float* bufs[37];
+        const size_t frames = FRAMES / 8;
+        for (size_t i = 0; i < bank.count; i++) {
+                bufs[i] = i % 5 == 4 ? NULL : out + i * frames;
+                memcpy(out + i * frames, signal_a + i * frames, frames * sizeof(float));
+        }
+        k->fader_bank_process(&bank, bufs, frames);
+        size_t n = bank.count * frames;
+        n += bank_output(&bank, out + n);
+        qx_fader_bank_free(&bank);
+        return n;
+}
+
+static size_t run_fader_curve_array(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int c = 0; c <= QX_FADER_CURVE_RAISED_COSINE; c++)
+                k->fader_curve_array((enum qx_fader_curve)c, gains, out + c * FRAMES, FRAMES);
+        return 5 * FRAMES;
+}
+
+static size_t run_crossfader_process_block(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_crossfader xf;
+        qx_crossfader_init(&xf, 5.0f, 48000.0f);
+        qx_crossfader_set_curve(&xf, QX_FADER_CURVE_EQUAL_POWER);
+        qx_crossfader_start(&xf, true, 100);
+        k->crossfader_process_block(&xf, signal_a, signal_b, out, FRAMES);
+        qx_crossfader_start(&xf, false, 0);
+        k->crossfader_process_block(&xf, signal_a, signal_b, out + FRAMES, FRAMES);
+        return 2 * FRAMES;
+}
+
+static size_t run_smoother_process_block(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int shape = 0; shape <= QX_SMOOTHER_SCURVE; shape++) {
+                qx_smoother s;
+                qx_smoother_init(&s, 0.2f, 500);
+                qx_smoother_set_shape(&s, (enum qx_smoother_shape)shape);
+                qx_smoother_set_target(&s, 0.9f);
+                k->smoother_process_block(&s, out + shape * FRAMES, FRAMES);
+        }
+        return 4 * FRAMES;
+}
+
+static size_t run_smoother_apply_gain_block(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int shape = 0; shape <= QX_SMOOTHER_SCURVE; shape++) {
+                qx_smoother s;
+                qx_smoother_init(&s, 1.0f, 700);
+                qx_smoother_set_shape(&s, (enum qx_smoother_shape)shape);
+                qx_smoother_set_target(&s, 0.1f);
+                k->smoother_apply_gain_block(&s, signal_a, out + shape * FRAMES, FRAMES);
+        }
+        return 4 * FRAMES;
+}
+
+static size_t run_smoother_bank_process(const struct qx_dsp_kernels* k, float* out)
+{
+        qx_smoother_bank bank;
+        if (!qx_smoother_bank_init(&bank, 8, 0.5f, 300))
+                return 0;
+        float* outs[8];
+        const size_t frames = FRAMES / 8;
+        for (size_t i = 0; i < 8; i++) {
+                outs[i] = out + i * frames;
+                qx_smoother_bank_set_frames(&bank, i, 50 * (i + 1));
+                qx_smoother_bank_set_shape(&bank, i, (enum qx_smoother_shape)(i % 4));
+                if (i != 5)
+                        qx_smoother_bank_set_target(&bank, i, 0.1f * (float)(i + 1));
+        }
+        k->smoother_bank_process(&bank, outs, frames);
+        qx_smoother_bank_free(&bank);
+        return 8 * frames;
+}
+
+static size_t run_randomizer_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int type = 0; type <= QX_RANDOM_ENGINE_PHILOX; type++) {
+                struct qx_randomizer rand;
+                struct qx_random_engine engine;
+                qx_randomizer_init_seed(&rand, &engine, (enum qx_random_engine_type)type,
+                                        1234u, -1.0f, 1.0f, 1e-6f);
+                k->randomizer_fill(&rand, out + type * FRAMES, FRAMES);
+        }
+        return 5 * FRAMES;
+}
+
+static size_t run_randomizer_fill_at(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_randomizer rand;
+        qx_randomizer_init_seed(&rand, NULL, QX_RANDOM_ENGINE_LCG, 99u, 0.0f, 10.0f, 0.001f);
+        k->randomizer_fill_at(&rand, 0x123456789abcdefull, 17u, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_random_engine_fill_u32(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int type = 0; type <= QX_RANDOM_ENGINE_PHILOX; type++) {
+                struct qx_random_engine engine;
+                uint32_t raw[FRAMES];
+                qx_random_engine_seed(&engine, (enum qx_random_engine_type)type, 777u);
+                k->random_engine_fill_u32(&engine, raw, FRAMES);
+                memcpy(out + type * FRAMES, raw, sizeof(raw));
+        }
+        return 5 * FRAMES;
+}
+
+static size_t run_random_fill_at(const struct qx_dsp_kernels* k, float* out)
+{
+        uint32_t raw[FRAMES];
+        k->random_fill_at(42u, 1000u, raw, FRAMES);
+        memcpy(out, raw, sizeof(raw));
+        return FRAMES;
+}
+
+static size_t run_randomizer_fill_u32(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int type = 0; type <= QX_RANDOM_ENGINE_PHILOX; type++) {
+                struct qx_randomizer rand;
+                struct qx_random_engine engine;
+                uint32_t raw[FRAMES];
+                qx_randomizer_init_seed(&rand, &engine, (enum qx_random_engine_type)type,
+                                        5u, 0.0f, 1.0f, 1e-6f);
+                k->randomizer_fill_u32(&rand, raw, FRAMES);
+                memcpy(out + type * FRAMES, raw, sizeof(raw));
+        }
+        return 5 * FRAMES;
+}
+
+static void dist_randomizer(struct qx_randomizer* rand, struct qx_random_engine* engine)
+{
+        qx_randomizer_init_seed(rand, engine, QX_RANDOM_ENGINE_XOSHIRO128P, 2024u, 0.0f, 1.0f, 1e-6f);
+}
+
+static size_t run_dist_normal_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        dist_randomizer(&rand, &engine);
+        k->dist_normal_fill(&rand, 0.5f, 2.0f, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_dist_exponential_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        dist_randomizer(&rand, &engine);
+        k->dist_exponential_fill(&rand, 3.0f, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_dist_triangular_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        dist_randomizer(&rand, &engine);
+        k->dist_triangular_fill(&rand, -2.0f, 5.0f, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_dist_icdf_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        struct qx_icdf_table table;
+        if (!qx_icdf_table_init_poisson(&table, 4.5f, 10))
+                return 0;
+        dist_randomizer(&rand, &engine);
+        k->dist_icdf_fill(&rand, &table, out, FRAMES);
+        qx_icdf_table_free(&table);
+        return FRAMES;
+}
+
+static size_t run_noise_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        for (int color = 0; color <= QX_NOISE_VELVET; color++) {
+                struct qx_noise noise;
+                qx_noise_init(&noise, (enum qx_noise_color)color, 48000.0f);
+                qx_noise_set_seed(&noise, 31337u);
+                k->noise_fill(&noise, out + color * FRAMES, FRAMES);
+        }
+        return 5 * FRAMES;
+}
+
+typedef void (*array_float_fn)(const float* in, float* out, size_t n, float min, float max);
+typedef void (*array_double_fn)(const double* in, double* out, size_t n, double min, double max);
+
+static size_t run_array_float(array_float_fn fn, float* out)
+{
+        fn(signal_a, out, FRAMES, -0.5f, 0.75f);
+        return FRAMES;
+}
+
+static size_t run_array_double(array_double_fn fn, float* out)
+{
+        double in[FRAMES];
+        double res[FRAMES];
+        for (size_t i = 0; i < FRAMES; i++)
+                in[i] = (double)signal_a[i] * 1.1;
+        fn(in, res, FRAMES, -0.5, 0.75);
+        memcpy(out, res, sizeof(res));
+        return 2 * FRAMES;
+}
+
+static size_t run_normalize_array_float(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_float(k->normalize_array_float, out);
+}
+
+static size_t run_normalize_clamp_array_float(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_float(k->normalize_clamp_array_float, out);
+}
+
+static size_t run_denormalize_array_float(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_float(k->denormalize_array_float, out);
+}
+
+static size_t run_denormalize_clamp_array_float(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_float(k->denormalize_clamp_array_float, out);
+}
+
+static size_t run_clamp_array_float(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_float(k->clamp_array_float, out);
+}
+
+static size_t run_normalize_array_double(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_double(k->normalize_array_double, out);
+}
+
+static size_t run_normalize_clamp_array_double(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_double(k->normalize_clamp_array_double, out);
+}
+
+static size_t run_denormalize_array_double(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_double(k->denormalize_array_double, out);
+}
+
+static size_t run_denormalize_clamp_array_double(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_double(k->denormalize_clamp_array_double, out);
+}
+
+static size_t run_clamp_array_double(const struct qx_dsp_kernels* k, float* out)
+{
+        return run_array_double(k->clamp_array_double, out);
+}
+
+static size_t run_db_to_val_array(const struct qx_dsp_kernels* k, float* out)
+{
+        float db[FRAMES];
+        fill_uniform(db, FRAMES, -200.0f, 60.0f, 7u);
+        k->db_to_val_array(db, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_val_to_db_array(const struct qx_dsp_kernels* k, float* out)
+{
+        float val[FRAMES];
+        fill_uniform(val, FRAMES, -200.0f, 60.0f, 8u);
+        for (size_t i = 0; i < FRAMES; i++)
+                val[i] = powf(10.0f, val[i] / 20.0f);
+        k->val_to_db_array(val, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_wrapf_array(const struct qx_dsp_kernels* k, float* out)
+{
+        float in[FRAMES];
+        fill_uniform(in, FRAMES, -1000.0f, 1000.0f, 9u);
+        k->wrapf_array(in, out, FRAMES, 2.5f);
+        return FRAMES;
+}
+
+static size_t run_phase_fill(const struct qx_dsp_kernels* k, float* out)
+{
+        float phase = 0.25f;
+        k->phase_fill(&phase, 0.0123f, out, FRAMES);
+        out[FRAMES] = phase;
+        return FRAMES + 1;
+}
+
+static size_t run_ring_read_linear_block(const struct qx_dsp_kernels* k, float* out)
+{
+        k->ring_read_linear_block(ring, RING_SIZE, ring_index, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_ring_read_hermite_block(const struct qx_dsp_kernels* k, float* out)
+{
+        k->ring_read_hermite_block(ring, RING_SIZE, ring_index, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_ring_read_lagrange4_block(const struct qx_dsp_kernels* k, float* out)
+{
+        k->ring_read_lagrange4_block(ring, RING_SIZE, ring_index, out, FRAMES);
+        return FRAMES;
+}
+
+static size_t run_ring_read_sinc_block(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_sinc_table table;
+        if (!qx_sinc_table_init(&table, 16, 256))
+                return 0;
+        k->ring_read_sinc_block(&table, ring, RING_SIZE, ring_index, out, FRAMES);
+        qx_sinc_table_free(&table);
+        return FRAMES;
+}
+
+/** Delay line holding two blocks of signal a. */
+static bool delay_line_setup(struct qx_delay_line* line)
+{
+        if (!qx_delay_line_init(line, 2048, FRAMES))
+                return false;
+        for (int i = 0; i < 2; i++) {
+                qx_delay_line_write(line, signal_a + i * FRAMES, FRAMES);
+                qx_delay_line_advance(line, FRAMES);
+        }
+        return true;
+}
+
+static size_t run_delay_line_read(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_delay_line line;
+        if (!delay_line_setup(&line))
+                return 0;
+        k->delay_line_read(&line, delays, out, FRAMES);
+        qx_delay_line_free(&line);
+        return FRAMES;
+}
+
+static size_t run_delay_line_read_hermite(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_delay_line line;
+        if (!delay_line_setup(&line))
+                return 0;
+        k->delay_line_read_hermite(&line, delays, out, FRAMES);
+        qx_delay_line_free(&line);
+        return FRAMES;
+}
+
+static size_t run_delay_line_read_fixed(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_delay_line line;
+        if (!delay_line_setup(&line))
+                return 0;
+        k->delay_line_read_fixed(&line, 123.25f, out, FRAMES);
+        k->delay_line_read_fixed(&line, 1500.0f, out + FRAMES, FRAMES);
+        qx_delay_line_free(&line);
+        return 2 * FRAMES;
+}
+
+static size_t run_delay_line_process(const struct qx_dsp_kernels* k, float* out)
+{
+        struct qx_delay_line line;
+        if (!delay_line_setup(&line))
+                return 0;
+        k->delay_line_process(&line, signal_b, delays, out, FRAMES);
+        k->delay_line_process(&line, signal_a, delays, out + FRAMES, FRAMES);
+        qx_delay_line_free(&line);
+        return 2 * FRAMES;
+}
+
+#define KERNEL(name, tol) { #name, run_##name, &tol }
+
+static const struct kernel_case kernel_cases[] = {
+        KERNEL(simd_ramp_fill, ulps),
+        KERNEL(simd_ramp_mul, ulps),
+        KERNEL(simd_mul, ulps),
+        KERNEL(simd_scale, ulps),
+        KERNEL(simd_mix, ulps),
+        KERNEL(simd_mix_gain, ulps),
+
+        KERNEL(fader_process_block, ulps),
+        KERNEL(fader_process_block_out, ulps),
+        KERNEL(fader_process_block_end, ulps),
+        KERNEL(fader_process_block_end_out, ulps),
+        KERNEL(fader_process_interleaved, ulps),
+        KERNEL(fader_process_interleaved_out, ulps),
+        KERNEL(fader_bank_advance, ulps),
+        KERNEL(fader_bank_set_time, ulps),
+        KERNEL(fader_bank_set_sample_rate, ulps),
+        KERNEL(fader_bank_process, ulps),
+        KERNEL(fader_curve_array, ulps),
+
+        KERNEL(crossfader_process_block, ulps),
+
+        KERNEL(smoother_process_block, ulps),
+        KERNEL(smoother_apply_gain_block, ulps),
+        KERNEL(smoother_bank_process, ulps),
+
+        KERNEL(randomizer_fill, exact),
+        KERNEL(randomizer_fill_at, exact),
+        KERNEL(random_engine_fill_u32, exact),
+        KERNEL(random_fill_at, exact),
+        KERNEL(randomizer_fill_u32, exact),
+
+        KERNEL(dist_normal_fill, exact),
+        KERNEL(dist_exponential_fill, ulps),
+        KERNEL(dist_triangular_fill, exact),
+        KERNEL(dist_icdf_fill, exact),
+
+        KERNEL(noise_fill, exact),
+
+        KERNEL(normalize_array_float, exact),
+        KERNEL(normalize_clamp_array_float, exact),
+        KERNEL(denormalize_array_float, exact),
+        KERNEL(denormalize_clamp_array_float, exact),
+        KERNEL(clamp_array_float, exact),
+        KERNEL(normalize_array_double, exact),
+        KERNEL(normalize_clamp_array_double, exact),
+        KERNEL(denormalize_array_double, exact),
+        KERNEL(denormalize_clamp_array_double, exact),
+        KERNEL(clamp_array_double, exact),
+        KERNEL(db_to_val_array, db_to_val),
+        KERNEL(val_to_db_array, val_to_db),
+        KERNEL(wrapf_array, exact),
+        KERNEL(phase_fill, ulps),
+
+        KERNEL(ring_read_linear_block, ulps),
+        KERNEL(ring_read_hermite_block, ulps),
+        KERNEL(ring_read_lagrange4_block, ulps),
+        KERNEL(ring_read_sinc_block, ulps),
+
+        KERNEL(delay_line_read, ulps),
+        KERNEL(delay_line_read_hermite, ulps),
+        KERNEL(delay_line_read_fixed, ulps),
+        KERNEL(delay_line_process, ulps),
+};
+
+static float expected[OUT_MAX];
+static float actual[OUT_MAX];
+
+static void compare(const struct kernel_case* c, enum qx_dsp_isa isa, size_t n)
+{
+        const char* name = qx_dsp_isa_name(isa);
+        if (c->tol->abs == 0.0 && c->tol->rel == 0.0) {
+                for (size_t i = 0; i < n; i++) {
+                        if (memcmp(&expected[i], &actual[i], sizeof(float)) != 0) {
+                                QX_CHECK(false, "%s %s: %.9g instead of %.9g at %zu",
+                                         name, c->name, actual[i], expected[i], i);
+                                return;
+                        }
+                }
+                return;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+                double diff = fabs((double)actual[i] - (double)expected[i]);
+                if (!(diff <= c->tol->abs + c->tol->rel * fabs((double)expected[i]))) {
+                        QX_CHECK(false, "%s %s: %.9g instead of %.9g at %zu",
+                                 name, c->name, actual[i], expected[i], i);
+                        return;
+                }
+        }
+}
+
+int main(void)
+{
+        fill_uniform(signal_a, OUT_MAX, -1.0f, 1.0f, 1u);
+        fill_uniform(signal_b, OUT_MAX, -1.0f, 1.0f, 2u);
+        fill_uniform(gains, OUT_MAX, 0.0f, 1.0f, 3u);
+        fill_uniform(ring, RING_SIZE, -1.0f, 1.0f, 4u);
+        fill_uniform(ring_index, FRAMES, 0.0f, (float)RING_SIZE, 5u);
+        fill_uniform(delays, FRAMES, 0.0f, 2000.0f, 6u);
+
+        const size_t count = sizeof(kernel_cases) / sizeof(kernel_cases[0]);
+        for (int isa = QX_DSP_ISA_SCALAR + 1; isa < QX_DSP_ISA_COUNT; isa++) {
+                if (!qx_dsp_isa_supported((enum qx_dsp_isa)isa))
+                        continue;
+
+                for (size_t c = 0; c < count; c++) {
+                        qx_dsp_set_isa(QX_DSP_ISA_SCALAR);
+                        size_t n = kernel_cases[c].run(qx_dsp(), expected);
+                        qx_dsp_set_isa((enum qx_dsp_isa)isa);
+                        QX_CHECK(kernel_cases[c].run(qx_dsp(), actual) == n && n > 0,
+                                 "%s %s: no output", qx_dsp_isa_name((enum qx_dsp_isa)isa),
+                                 kernel_cases[c].name);
+                        compare(&kernel_cases[c], (enum qx_dsp_isa)isa, n);
+                }
+        }
+
+        return qx_test_result("test_dsp_tables");
+}
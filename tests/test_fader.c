@@ -0,0 +1,424 @@
+/**
+ * @file test_fader.c
+ * @brief Block fader processing against qx_fader_fade().
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * A linear fade of 5 ms at 48 kHz must ramp the gain by 1/240 per frame
+ * and reach 1 or 0 after 240 frames, after which an open fader copies the
+ * input and a closed one writes silence. The block functions must match
+ * qx_fader_fade() called for every sample to float rounding, for every
+ * curve, both directions, fades starting in the middle and blocks that
+ * end before, at and after the end of the fade. The state after each
+ * block must match as well. A fade that ends on the last frame of a
+ * block and one that is still ramping both make block_end return the
+ * block size; the state must tell them apart. Disabling a fader in the
+ * middle of a fade-in must continue down from the current gain with
+ * retrigger on, and restart from 1 with it off. A fade time given to
+ * qx_fader_enable_time() must hold until the next qx_fader_enable(),
+ * even across qx_fader_set_time(). qx_fader_set_time() and
+ * qx_fader_set_sample_rate() must keep the fade position, and a new
+ * sample rate must keep the remaining fade time in milliseconds. A fader bank must give the same result as
+ * loading every voice, running qx_fader_fade() on it and storing it back.
+ */
+
+#include "qx_fader.h"
+#include "qx_test.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAMES 1000
+#define FADE_FRAMES 240
+#define TOLERANCE 1e-5f
+#define VOICES 37
+
+/* The bank fades last up to 37 ms, so qx_fader_fade() sums the step over
+ * the whole buffer and accumulates one rounding per frame. */
+#define BANK_TOLERANCE (FRAMES * FLT_EPSILON)
+
+static float input[4 * FRAMES];
+
+static void fader_setup(struct qx_fader* fader, enum qx_fader_curve curve, bool enabled, float fade)
+{
+        qx_fader_init(fader, 5.0f, 48000.0f);
+        qx_fader_set_curve(fader, curve);
+        qx_fader_set_retrigger(fader, true);
+        fader->fade = fade;
+        qx_fader_enable(fader, enabled);
+}
+
+static void check_ramp(bool enabled, size_t block)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_LINEAR, enabled, enabled ? 0.0f : 1.0f);
+
+        float out[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                memcpy(out + pos, input + pos, n * sizeof(float));
+                qx_fader_process_block(&fader, out + pos, n);
+        }
+
+        for (size_t i = 0; i < FRAMES; i++) {
+                float x = (float)(i + 1) / FADE_FRAMES;
+                float gain = enabled ? fminf(x, 1.0f) : fmaxf(1.0f - x, 0.0f);
+                if (i >= FADE_FRAMES) {
+                        float expected = enabled ? input[i] : 0.0f;
+                        QX_CHECK(out[i] == expected, "ramp enabled %d block %zu: %g instead of %g at %zu",
+                                 enabled, block, out[i], expected, i);
+                } else {
+                        QX_CHECK(fabsf(out[i] - input[i] * gain) <= TOLERANCE,
+                                 "ramp enabled %d block %zu: gain %g instead of %g at %zu",
+                                 enabled, block, out[i] / input[i], gain, i);
+                }
+        }
+        QX_CHECK(qx_fader_get_state(&fader) == (enabled ? QX_FADER_STATE_OPEN : QX_FADER_STATE_SILENT),
+                 "ramp enabled %d block %zu: not finished", enabled, block);
+}
+
+static void check_block(enum qx_fader_curve curve, bool enabled, float fade, size_t block)
+{
+        struct qx_fader ref, blk;
+        fader_setup(&ref, curve, enabled, fade);
+        fader_setup(&blk, curve, enabled, fade);
+
+        float out[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                qx_fader_process_block_out(&blk, input + pos, out + pos, n);
+                for (size_t i = pos; i < pos + n; i++) {
+                        float expected = qx_fader_fade(&ref, input[i]);
+                        if (!(fabsf(out[i] - expected) <= TOLERANCE)) {
+                                QX_CHECK(false, "curve %d enabled %d fade %g block %zu: %g instead of %g at %zu",
+                                         curve, enabled, fade, block, out[i], expected, i);
+                                return;
+                        }
+                }
+                QX_CHECK(fabsf(blk.fade - ref.fade) <= TOLERANCE,
+                         "curve %d block %zu: fade %g instead of %g after %zu",
+                         curve, block, blk.fade, ref.fade, pos + n);
+        }
+}
+
+static void check_block_end(enum qx_fader_curve curve, bool enabled, float fade, size_t block)
+{
+        struct qx_fader ref, blk;
+        fader_setup(&ref, curve, enabled, fade);
+        fader_setup(&blk, curve, enabled, fade);
+        const float target = enabled ? 1.0f : 0.0f;
+
+        float out[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                memcpy(out + pos, input + pos, n * sizeof(float));
+                size_t end = qx_fader_process_block_end(&blk, out + pos, n);
+                QX_CHECK(end <= n, "block_end: %zu of %zu frames", end, n);
+
+                for (size_t i = pos; i < pos + n; i++) {
+                        float expected = qx_fader_fade(&ref, input[i]);
+                        QX_CHECK(fabsf(out[i] - expected) <= TOLERANCE,
+                                 "block_end curve %d: %g instead of %g at %zu", curve, out[i], expected, i);
+                        if (i >= pos + end)
+                                QX_CHECK(out[i] == input[i] * target,
+                                         "block_end curve %d: %g after the end at %zu", curve, out[i], i);
+                }
+                if (end < n)
+                        QX_CHECK(qx_fader_get_state(&blk) == (enabled ? QX_FADER_STATE_OPEN
+                                                                     : QX_FADER_STATE_SILENT),
+                                 "block_end curve %d: not finished after %zu", curve, pos + n);
+        }
+}
+
+/*
+ * Fades of 4 and 8 frames in blocks of 4: the first ends on the last
+ * frame of the first block, the second on the last frame of the second.
+ */
+static void check_block_end_last(bool enabled)
+{
+        const enum qx_fader_state target = enabled ? QX_FADER_STATE_OPEN : QX_FADER_STATE_SILENT;
+        const enum qx_fader_state ramping = enabled ? QX_FADER_STATE_FADING_IN : QX_FADER_STATE_FADING_OUT;
+
+        for (size_t fade_frames = 4; fade_frames <= 8; fade_frames += 4) {
+                struct qx_fader fader;
+                fader_setup(&fader, QX_FADER_CURVE_LINEAR, !enabled, enabled ? 0.0f : 1.0f);
+                qx_fader_set_time(&fader, 1000.0f * (float)fade_frames / 48000.0f);
+                qx_fader_enable(&fader, enabled);
+
+                float out[4];
+                for (size_t pos = 0; pos < 12; pos += 4) {
+                        size_t end = qx_fader_process_block_end_out(&fader, input + pos, out, 4);
+                        size_t expected = pos < fade_frames ? 4 : 0;
+                        enum qx_fader_state state = pos + 4 < fade_frames ? ramping : target;
+                        QX_CHECK(end == expected, "block_end %zu-frame fade enabled %d: %zu instead of %zu after %zu",
+                                 fade_frames, enabled, end, expected, pos + 4);
+                        QX_CHECK(qx_fader_get_state(&fader) == state,
+                                 "block_end %zu-frame fade enabled %d: state %d instead of %d after %zu",
+                                 fade_frames, enabled, qx_fader_get_state(&fader), state, pos + 4);
+                }
+        }
+}
+
+/*
+ * Fade in for 100 frames, then disable: the gain continues down from
+ * 100/240 with retrigger, restarts from 1 without it.
+ */
+static void check_retrigger(bool retrigger, size_t block)
+{
+        static float ones[FRAMES];
+        for (size_t i = 0; i < FRAMES; i++)
+                ones[i] = 1.0f;
+
+        struct qx_fader ref, blk;
+        fader_setup(&ref, QX_FADER_CURVE_LINEAR, true, 0.0f);
+        fader_setup(&blk, QX_FADER_CURVE_LINEAR, true, 0.0f);
+        qx_fader_set_retrigger(&ref, retrigger);
+        qx_fader_set_retrigger(&blk, retrigger);
+
+        float gain[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                if (pos == 100) {
+                        qx_fader_enable(&ref, false);
+                        qx_fader_enable(&blk, false);
+                }
+                qx_fader_process_block_out(&blk, ones, gain + pos, n);
+                for (size_t i = pos; i < pos + n; i++) {
+                        float t = (float)i + 1.0f;
+                        float x = i < 100 ? t : retrigger ? 200.0f - t : FADE_FRAMES + 100.0f - t;
+                        float expected = fmaxf(x / FADE_FRAMES, 0.0f);
+                        float fade = qx_fader_fade(&ref, 1.0f);
+                        if (!(fabsf(gain[i] - expected) <= TOLERANCE && fabsf(fade - expected) <= TOLERANCE)) {
+                                QX_CHECK(false, "retrigger %d block %zu: gains %g, %g instead of %g at %zu",
+                                         retrigger, block, gain[i], fade, expected, i);
+                                return;
+                        }
+                }
+        }
+}
+
+static void run_frames(struct qx_fader* fader, size_t frames)
+{
+        for (size_t i = 0; i < frames; i++)
+                qx_fader_fade(fader, 1.0f);
+}
+
+static void check_fade(const struct qx_fader* fader, float expected, const char* what)
+{
+        QX_CHECK(fabsf(fader->fade - expected) <= TOLERANCE, "%s: fade %g instead of %g",
+                 what, fader->fade, expected);
+}
+
+static void check_time_override(void)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_LINEAR, false, 0.0f);
+
+        // 2.5 ms: 120 frames, while the configured 5 ms are 240
+        qx_fader_enable_time(&fader, true, 2.5f);
+        run_frames(&fader, 60);
+        check_fade(&fader, 0.5f, "override");
+
+        qx_fader_set_time(&fader, 10.0f);
+        check_fade(&fader, 0.5f, "set_time during override");
+        run_frames(&fader, 30);
+        check_fade(&fader, 0.75f, "override after set_time");
+
+        // The next enable runs at the configured time, now 10 ms: 480 frames
+        qx_fader_enable(&fader, false);
+        run_frames(&fader, 48);
+        check_fade(&fader, 0.65f, "enable after override");
+}
+
+static void check_set_time(void)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_LINEAR, true, 0.0f);
+        run_frames(&fader, 120);
+        check_fade(&fader, 0.5f, "set_time");
+
+        qx_fader_set_time(&fader, 10.0f);
+        check_fade(&fader, 0.5f, "set_time");
+        run_frames(&fader, 48);
+        check_fade(&fader, 0.6f, "after set_time");
+
+        qx_fader_set_time(&fader, 0.0f);
+        check_fade(&fader, 0.6f, "set_time instant");
+        run_frames(&fader, 1);
+        check_fade(&fader, 1.0f, "after set_time instant");
+}
+
+static void check_sample_rate(void)
+{
+        struct qx_fader fader;
+        fader_setup(&fader, QX_FADER_CURVE_LINEAR, true, 0.0f);
+        run_frames(&fader, 120);
+
+        // The remaining 2.5 ms are 240 frames at 96 kHz
+        qx_fader_set_sample_rate(&fader, 96000.0f);
+        check_fade(&fader, 0.5f, "set_sample_rate");
+        run_frames(&fader, 120);
+        check_fade(&fader, 0.75f, "after set_sample_rate");
+        run_frames(&fader, 120);
+        QX_CHECK(qx_fader_get_state(&fader) == QX_FADER_STATE_OPEN, "set_sample_rate: not open after 5 ms");
+
+        // A 2 ms override fade-out at 96 kHz: 192 frames, then 1 ms left is 24 frames at 24 kHz
+        qx_fader_enable_time(&fader, false, 2.0f);
+        run_frames(&fader, 96);
+        qx_fader_set_sample_rate(&fader, 24000.0f);
+        check_fade(&fader, 0.5f, "set_sample_rate during override");
+        run_frames(&fader, 12);
+        check_fade(&fader, 0.25f, "override after set_sample_rate");
+
+        // The configured 5 ms at 24 kHz: 120 frames
+        qx_fader_enable(&fader, true);
+        run_frames(&fader, 60);
+        check_fade(&fader, 0.75f, "enable after set_sample_rate");
+
+        qx_fader_set_time(&fader, 0.0f);
+        qx_fader_set_sample_rate(&fader, 44100.0f);
+        qx_fader_enable(&fader, false);
+        run_frames(&fader, 1);
+        check_fade(&fader, 0.0f, "instant fade after set_sample_rate");
+}
+
+static void check_interleaved(enum qx_fader_curve curve, bool enabled, size_t channels)
+{
+        struct qx_fader ref, blk;
+        fader_setup(&ref, curve, enabled, 0.5f);
+        fader_setup(&blk, curve, enabled, 0.5f);
+
+        const size_t frames = FRAMES / channels;
+        float out[FRAMES];
+        qx_fader_process_interleaved_out(&blk, input, out, frames, channels);
+        for (size_t f = 0; f < frames; f++) {
+                float gain = qx_fader_fade(&ref, 1.0f);
+                for (size_t c = 0; c < channels; c++) {
+                        size_t i = f * channels + c;
+                        QX_CHECK(fabsf(out[i] - input[i] * gain) <= TOLERANCE,
+                                 "interleaved curve %d channels %zu: %g instead of %g at %zu",
+                                 curve, channels, out[i], input[i] * gain, i);
+                }
+        }
+}
+
+static bool bank_setup(struct qx_fader_bank* bank)
+{
+        if (!qx_fader_bank_init(bank, VOICES, 5.0f, 48000.0f))
+                return false;
+        qx_fader_bank_set_retrigger(bank, true);
+        qx_fader_bank_set_curve(bank, QX_FADER_CURVE_EQUAL_POWER);
+        for (size_t v = 0; v < VOICES; v++) {
+                bank->fade[v] = (float)v / VOICES;
+                if (v % 3 == 0)
+                        qx_fader_bank_enable_time(bank, v, v % 2 == 0, 1.0f + (float)v);
+                else
+                        qx_fader_bank_enable(bank, v, v % 2 == 0);
+        }
+        return true;
+}
+
+static void check_bank(size_t block)
+{
+        struct qx_fader_bank ref, blk;
+        float* out = (float*)malloc(VOICES * FRAMES * sizeof(float));
+        if (!bank_setup(&ref) || !bank_setup(&blk) || !out) {
+                QX_CHECK(false, "bank: out of memory");
+                exit(1);
+        }
+
+        float* bufs[VOICES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                for (size_t v = 0; v < VOICES; v++) {
+                        bufs[v] = out + v * FRAMES + pos;
+                        memcpy(bufs[v], input + pos, n * sizeof(float));
+                }
+                qx_fader_bank_process(&blk, bufs, n);
+
+                for (size_t v = 0; v < VOICES; v++) {
+                        struct qx_fader fader;
+                        qx_fader_bank_load(&ref, v, &fader);
+                        bool reported = false;
+                        for (size_t i = pos; i < pos + n; i++) {
+                                float expected = qx_fader_fade(&fader, input[i]);
+                                if (!reported && !(fabsf(out[v * FRAMES + i] - expected) <= BANK_TOLERANCE)) {
+                                        QX_CHECK(false, "bank block %zu voice %zu: %g instead of %g at %zu",
+                                                 block, v, out[v * FRAMES + i], expected, i);
+                                        reported = true;
+                                }
+                        }
+                        qx_fader_bank_store(&ref, v, &fader);
+                        QX_CHECK(fabsf(blk.fade[v] - ref.fade[v]) <= BANK_TOLERANCE,
+                                 "bank block %zu voice %zu: fade %g instead of %g after %zu",
+                                 block, v, blk.fade[v], ref.fade[v], pos + n);
+                }
+        }
+
+        free(out);
+        qx_fader_bank_free(&ref);
+        qx_fader_bank_free(&blk);
+}
+
+int main(void)
+{
+        for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++)
+                input[i] = sinf(0.05f * (float)i) * 0.9f;
+
+        static const size_t blocks[] = {1, 7, 64, 100, 333, FRAMES};
+        static const float starts[] = {0.0f, 0.37f, 1.0f};
+        static const size_t retrigger_blocks[] = {1, 4, 50, 100};
+        for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                check_ramp(true, blocks[b]);
+                check_ramp(false, blocks[b]);
+                check_bank(blocks[b]);
+        }
+        for (size_t b = 0; b < QX_TEST_COUNT(retrigger_blocks); b++) {
+                check_retrigger(true, retrigger_blocks[b]);
+                check_retrigger(false, retrigger_blocks[b]);
+        }
+        check_time_override();
+        check_set_time();
+        check_sample_rate();
+        check_block_end_last(true);
+        check_block_end_last(false);
+
+        for (int curve = 0; curve <= QX_FADER_CURVE_RAISED_COSINE; curve++) {
+                for (int enabled = 0; enabled < 2; enabled++) {
+                        for (size_t s = 0; s < QX_TEST_COUNT(starts); s++) {
+                                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                                        check_block((enum qx_fader_curve)curve, enabled, starts[s], blocks[b]);
+                                        check_block_end((enum qx_fader_curve)curve, enabled, starts[s], blocks[b]);
+                                }
+                        }
+                        check_interleaved((enum qx_fader_curve)curve, enabled, 1);
+                        check_interleaved((enum qx_fader_curve)curve, enabled, 2);
+                        check_interleaved((enum qx_fader_curve)curve, enabled, 3);
+                }
+        }
+
+        return qx_test_result("test_fader");
+}
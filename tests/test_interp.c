@@ -0,0 +1,174 @@
+/**
+ * @file test_interp.c
+ * @brief Block ring buffer reads against the single-index interpolators.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Every interpolator must return the samples at integer indices. Linear
+ * interpolation must reproduce a line, Catmull-Rom a parabola and
+ * Lagrange-4 a cubic at fractional indices away from the wrap, and the
+ * windowed sinc must reproduce a sine well below the Nyquist frequency
+ * that is periodic in the ring.
+ *
+ * The block readers must match the single-index interpolators for indices
+ * all over [0, 2 * size), including the samples next to the ends of the
+ * buffer where the neighbours wrap. The vector code may evaluate the
+ * polynomials in a different order, so values are compared within a few
+ * float ulps.
+ */
+
+#include "qx_interp.h"
+#include "qx_test.h"
+
+#include <math.h>
+
+#define RING_SIZE 509
+#define READS 1003
+#define TOLERANCE 4e-6f
+
+static float ring[RING_SIZE];
+static float indices[READS];
+static struct qx_sinc_table sinc;
+
+typedef void (*block_fn)(const float* buf, int size, const float* index, float* out, size_t n);
+typedef float (*single_fn)(const float* buf, float index, int size);
+
+static float interp_sinc(const float* buf, float index, int size)
+{
+        return qx_ring_interp_sinc(&sinc, buf, index, size);
+}
+
+static void read_sinc_block(const float* buf, int size, const float* index, float* out, size_t n)
+{
+        qx_ring_read_sinc_block(&sinc, buf, size, index, out, n);
+}
+
+static float poly(int degree, float index)
+{
+        float x = (index - 250.0f) / 4.0f;
+        static const float c[4] = {0.3f, -0.7f, 0.4f, 0.5f};
+        float y = 0.0f;
+        for (int d = degree; d >= 0; d--)
+                y = y * x + c[d];
+        return y;
+}
+
+static void check_exact(const char* name, single_fn single, int degree)
+{
+        float buf[RING_SIZE];
+        for (int i = 0; i < RING_SIZE; i++)
+                buf[i] = poly(degree, (float)i);
+
+        for (float index = 240.0f; index < 260.0f; index += 0.37f) {
+                float expected = poly(degree, index);
+                float value = single(buf, index, RING_SIZE);
+                if (!(fabsf(value - expected) <= 2e-5f * fmaxf(fabsf(expected), 1.0f))) {
+                        QX_CHECK(false, "%s degree %d: %.9g instead of %.9g at index %.6f",
+                                 name, degree, value, expected, index);
+                        return;
+                }
+        }
+}
+
+static void check_samples(const char* name, single_fn single)
+{
+        for (int i = 0; i < RING_SIZE; i++) {
+                float value = single(ring, (float)i, RING_SIZE);
+                QX_CHECK(fabsf(value - ring[i]) <= 1e-6f, "%s: %.9g instead of the sample %.9g at %d",
+                         name, value, ring[i], i);
+        }
+}
+
+static void check_sinc_sine(void)
+{
+        float buf[RING_SIZE];
+        const double w = 2.0 * M_PI * 20.0 / RING_SIZE;
+        for (int i = 0; i < RING_SIZE; i++)
+                buf[i] = (float)sin(w * i);
+
+        float worst = 0.0f;
+        for (float index = 0.0f; index < RING_SIZE; index += 0.37f)
+                worst = fmaxf(worst, fabsf(interp_sinc(buf, index, RING_SIZE) - (float)sin(w * index)));
+        QX_CHECK(worst <= 1e-3f, "sinc: error %g on a sine of 20 periods in the ring", worst);
+}
+
+static void check_reader(const char* name, block_fn block, single_fn single)
+{
+        static const size_t lengths[] = {1, 3, 8, 13, READS};
+        float out[READS];
+        for (size_t l = 0; l < QX_TEST_COUNT(lengths); l++) {
+                size_t n = lengths[l];
+                block(ring, RING_SIZE, indices + READS - n, out, n);
+                for (size_t i = 0; i < n; i++) {
+                        float index = indices[READS - n + i];
+                        float expected = single(ring, index, RING_SIZE);
+                        if (!(fabsf(out[i] - expected) <= TOLERANCE)) {
+                                QX_CHECK(false, "%s n %zu: %.9g instead of %.9g at index %.6f",
+                                         name, n, out[i], expected, index);
+                                break;
+                        }
+                }
+        }
+}
+
+int main(void)
+{
+        for (int i = 0; i < RING_SIZE; i++)
+                ring[i] = sinf(0.3f * (float)i) * 0.8f + 0.1f * cosf(2.1f * (float)i);
+
+        // Edge positions first, then a sweep over [0, 2 * size)
+        static const float edges[] = {0.0f, 0.25f, 1.0f, 1.5f, RING_SIZE - 2.0f, RING_SIZE - 1.5f,
+                                      RING_SIZE - 1.0f, RING_SIZE - 0.25f, RING_SIZE, RING_SIZE + 0.5f,
+                                      2 * RING_SIZE - 1.5f, 2 * RING_SIZE - 0.75f};
+        const size_t edge_count = QX_TEST_COUNT(edges);
+        for (size_t i = 0; i < READS; i++) {
+                if (i < edge_count)
+                        indices[i] = edges[i];
+                else
+                        indices[i] = fmodf(0.61803398875f * (float)(i * 37), 2.0f * RING_SIZE);
+                // Edges at both ends of the array, so the short blocks see them too
+                if (i >= READS - edge_count)
+                        indices[i] = edges[READS - 1 - i];
+        }
+
+        if (!qx_sinc_table_init(&sinc, 16, 256))
+                return 1;
+
+        check_samples("linear", qx_ring_interp_linear);
+        check_samples("hermite", qx_ring_interp_hermite);
+        check_samples("lagrange4", qx_ring_interp_lagrange4);
+        check_samples("sinc", interp_sinc);
+        check_exact("linear", qx_ring_interp_linear, 1);
+        check_exact("hermite", qx_ring_interp_hermite, 2);
+        check_exact("lagrange4", qx_ring_interp_lagrange4, 3);
+        check_sinc_sine();
+
+        check_reader("linear", qx_ring_read_linear_block, qx_ring_interp_linear);
+        check_reader("hermite", qx_ring_read_hermite_block, qx_ring_interp_hermite);
+        check_reader("lagrange4", qx_ring_read_lagrange4_block, qx_ring_interp_lagrange4);
+        check_reader("sinc", read_sinc_block, interp_sinc);
+
+        qx_sinc_table_free(&sinc);
+        return qx_test_result("test_interp");
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test_noise.c
+ * @brief Noise block fills against qx_noise_next().
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * qx_noise_fill() must produce exactly the samples of repeated
+ * qx_noise_next() calls and leave the generator in the same state, for
+ * every color and block size.
+ *
+ * The colors must also keep the promises of their documentation, on a
+ * fixed seed: pink noise in [-1, 1) and blue noise in (-1, 1) with the
+ * RMS of their sums of uniform rows (1/sqrt(51) and sqrt(64/867)),
+ * brown noise with an RMS of 0.25, and velvet noise with exactly one
+ * impulse of +1 or -1 in every period of sample_rate / density samples.
+ * The spectral slope, fitted over the octave bands from 43 Hz to 11 kHz
+ * of averaged Hann-windowed FFTs, must be -3 dB/octave for pink noise
+ * and +3 dB/octave for blue noise.
+ */
+
+#include "qx_noise.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <string.h>
+
+#define SAMPLES 3000
+#define FFT_SIZE 4096
+#define FFT_SEGMENTS 64
+
+static const char* const color_names[] = {"white", "pink", "brown", "blue", "velvet"};
+
+static const size_t blocks[] = {1, 5, 64, 255, 256, 1000, SAMPLES};
+
+static void noise_setup(struct qx_noise* noise, enum qx_noise_color color)
+{
+        qx_noise_init(noise, color, 44100.0f);
+        qx_noise_set_seed(noise, 1977u);
+        qx_noise_set_density(noise, 2205.0f);
+}
+
+static void check_fill(enum qx_noise_color color, size_t block)
+{
+        struct qx_noise ref, blk;
+        noise_setup(&ref, color);
+        noise_setup(&blk, color);
+
+        float out[SAMPLES];
+        for (size_t pos = 0; pos < SAMPLES; pos += block) {
+                size_t n = qx_test_block_frames(SAMPLES, pos, block);
+                qx_noise_fill(&blk, out + pos, n);
+        }
+        for (size_t i = 0; i < SAMPLES; i++) {
+                float expected = qx_noise_next(&ref);
+                if (memcmp(&out[i], &expected, sizeof(float)) != 0) {
+                        QX_CHECK(false, "%s block %zu: %.9g instead of %.9g at %zu",
+                                 color_names[color], block, out[i], expected, i);
+                        return;
+                }
+        }
+        for (size_t i = 0; i < 100; i++) {
+                float a = qx_noise_next(&blk);
+                float b = qx_noise_next(&ref);
+                if (memcmp(&a, &b, sizeof(float)) != 0) {
+                        QX_CHECK(false, "%s block %zu: different state after the fill",
+                                 color_names[color], block);
+                        return;
+                }
+        }
+}
+
+static void check_rms(struct qx_noise* noise, const char* name, size_t warmup, size_t samples,
+                      double expected, double tolerance)
+{
+        float out[1024];
+        for (size_t pos = 0; pos < warmup; pos += QX_TEST_COUNT(out))
+                qx_noise_fill(noise, out, qx_test_block_frames(warmup, pos, QX_TEST_COUNT(out)));
+
+        double sum = 0.0;
+        float min = 0.0f, max = 0.0f;
+        for (size_t pos = 0; pos < samples; pos += QX_TEST_COUNT(out)) {
+                size_t n = qx_test_block_frames(samples, pos, QX_TEST_COUNT(out));
+                qx_noise_fill(noise, out, n);
+                for (size_t i = 0; i < n; i++) {
+                        sum += (double)out[i] * out[i];
+                        min = fminf(min, out[i]);
+                        max = fmaxf(max, out[i]);
+                }
+        }
+        double rms = sqrt(sum / (double)samples);
+        QX_CHECK(fabs(rms - expected) < tolerance * expected, "%s: RMS %g instead of %g", name, rms, expected);
+
+        if (noise->color == QX_NOISE_PINK)
+                QX_CHECK(min >= -1.0f && max < 1.0f, "pink: values in [%g, %g] outside [-1, 1)", min, max);
+        else if (noise->color == QX_NOISE_BLUE)
+                QX_CHECK(min > -1.0f && max < 1.0f, "blue: values in [%g, %g] outside (-1, 1)", min, max);
+}
+
+static void check_velvet(float density, uint32_t period)
+{
+        struct qx_noise noise;
+        noise_setup(&noise, QX_NOISE_VELVET);
+        qx_noise_set_density(&noise, density);
+
+        float out[SAMPLES];
+        qx_noise_fill(&noise, out, SAMPLES);
+
+        size_t first = period, last = 0, positive = 0;
+        for (size_t start = 0; start + period <= SAMPLES; start += period) {
+                size_t impulses = 0, at = 0;
+                for (size_t i = start; i < start + period; i++) {
+                        if (out[i] != 0.0f) {
+                                impulses++;
+                                at = i - start;
+                        }
+                }
+                QX_CHECK(impulses == 1, "velvet density %g: %zu impulses in the period at %zu",
+                         density, impulses, start);
+                if (impulses != 1)
+                        return;
+                QX_CHECK(out[start + at] == 1.0f || out[start + at] == -1.0f,
+                         "velvet density %g: impulse %g at %zu", density, out[start + at], start + at);
+                positive += out[start + at] > 0.0f;
+                first = at < first ? at : first;
+                last = at > last ? at : last;
+        }
+
+        size_t periods = SAMPLES / period;
+        QX_CHECK(positive > periods / 4 && positive < periods - periods / 4,
+                 "velvet density %g: %zu positive impulses in %zu periods", density, positive, periods);
+        QX_CHECK(first < period / 4 && last >= period - period / 4,
+                 "velvet density %g: impulse positions only in [%zu, %zu] of %u",
+                 density, first, last, period);
+}
+
+/*
+ * In-place radix-2 FFT.
+ */
+static void fft(double* re, double* im, size_t n)
+{
+        for (size_t i = 1, j = 0; i < n; i++) {
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1)
+                        j ^= bit;
+                j |= bit;
+                if (i < j) {
+                        double t = re[i];
+                        re[i] = re[j];
+                        re[j] = t;
+                        t = im[i];
+                        im[i] = im[j];
+                        im[j] = t;
+                }
+        }
+        for (size_t len = 2; len <= n; len <<= 1) {
+                double step = -2.0 * M_PI / (double)len;
+                for (size_t i = 0; i < n; i += len) {
+                        for (size_t k = 0; k < len / 2; k++) {
+                                double wr = cos(step * (double)k);
+                                double wi = sin(step * (double)k);
+                                double* ar = &re[i + k];
+                                double* ai = &im[i + k];
+                                double* br = &re[i + k + len / 2];
+                                double* bi = &im[i + k + len / 2];
+                                double vr = *br * wr - *bi * wi;
+                                double vi = *br * wi + *bi * wr;
+                                *br = *ar - vr;
+                                *bi = *ai - vi;
+                                *ar += vr;
+                                *ai += vi;
+                        }
+                }
+        }
+}
+
+/*
+ * Least-squares slope in dB per octave of the mean power density in the
+ * octave bands [FFT_SIZE >> (b + 1), FFT_SIZE >> b) for b = 2..9.
+ */
+static double spectral_slope(enum qx_noise_color color)
+{
+        struct qx_noise noise;
+        noise_setup(&noise, color);
+
+        static double power[FFT_SIZE / 2];
+        static double re[FFT_SIZE], im[FFT_SIZE];
+        float out[FFT_SIZE];
+        memset(power, 0, sizeof(power));
+        for (int s = 0; s < FFT_SEGMENTS; s++) {
+                qx_noise_fill(&noise, out, FFT_SIZE);
+                for (size_t i = 0; i < FFT_SIZE; i++) {
+                        re[i] = (0.5 - 0.5 * cos(2.0 * M_PI * (double)i / FFT_SIZE)) * out[i];
+                        im[i] = 0.0;
+                }
+                fft(re, im, FFT_SIZE);
+                for (size_t k = 0; k < FFT_SIZE / 2; k++)
+                        power[k] += re[k] * re[k] + im[k] * im[k];
+        }
+
+        double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        int bands = 0;
+        for (int b = 2; b <= 9; b++) {
+                size_t lo = FFT_SIZE >> (b + 1), hi = FFT_SIZE >> b;
+                double p = 0.0;
+                for (size_t k = lo; k < hi; k++)
+                        p += power[k];
+                double x = -(double)b;
+                double y = 10.0 * log10(p / (double)(hi - lo));
+                sx += x;
+                sy += y;
+                sxx += x * x;
+                sxy += x * y;
+                bands++;
+        }
+        return (bands * sxy - sx * sy) / (bands * sxx - sx * sx);
+}
+
+int main(void)
+{
+        for (int color = 0; color <= QX_NOISE_VELVET; color++) {
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                        check_fill((enum qx_noise_color)color, blocks[b]);
+        }
+
+        struct qx_noise noise;
+        noise_setup(&noise, QX_NOISE_PINK);
+        check_rms(&noise, "pink", 0, 1u << 20, 1.0 / sqrt(51.0), 0.05);
+        noise_setup(&noise, QX_NOISE_BLUE);
+        check_rms(&noise, "blue", 0, 1u << 20, sqrt(64.0 / 867.0), 0.01);
+        noise_setup(&noise, QX_NOISE_BROWN);
+        check_rms(&noise, "brown", 1u << 14, 1u << 21, 0.25, 0.1);
+
+        check_velvet(2205.0f, 20);
+        check_velvet(441.0f, 100);
+        check_velvet(QX_NOISE_VELVET_DENSITY, 22);
+
+        double pink = spectral_slope(QX_NOISE_PINK);
+        double blue = spectral_slope(QX_NOISE_BLUE);
+        QX_CHECK(fabs(pink + 3.0) < 0.5, "pink: slope %.2f dB/octave instead of -3", pink);
+        QX_CHECK(fabs(blue - 3.0) < 0.5, "blue: slope %.2f dB/octave instead of +3", blue);
+
+        return qx_test_result("test_noise");
+}
@@ -0,0 +1,222 @@
+/**
+ * @file test_randomizer.c
+ * @brief Bulk random generation against the single-value calls.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * The LCG randomizer must produce the sequence seed * 1664525 + 1013904223
+ * and qx_randomizer_skip() must jump over it. Every engine must produce
+ * values in [min, max] on the resolution grid. Philox4x32-10, PCG32 and
+ * xoshiro128+ must reproduce the outputs of their reference
+ * implementations, also through the bulk fill and seeking.
+ *
+ * qx_randomizer_fill() and qx_randomizer_fill_u32() must produce exactly
+ * the values of repeated qx_randomizer_get_float() and
+ * qx_randomizer_next_u32() calls and leave the randomizer in the same
+ * state, for every engine and block size. qx_randomizer_fill_at() must
+ * match qx_randomizer_get_float_at().
+ */
+
+#include "qx_randomizer.h"
+#include "qx_test.h"
+
+#include <math.h>
+#include <string.h>
+
+#define VALUES 1000
+
+static const char* const engine_names[] = {"lcg", "xoshiro128+", "pcg32", "splitmix", "philox"};
+
+static const size_t blocks[] = {1, 3, 8, 61, 256, VALUES};
+
+static void randomizer_setup(struct qx_randomizer* rand,
+                             struct qx_random_engine* engine,
+                             enum qx_random_engine_type type)
+{
+        qx_randomizer_init_seed(rand, engine, type, 4321u, -3.0f, 5.0f, 0.001f);
+}
+
+static void check_lcg(size_t block)
+{
+        struct qx_randomizer rand;
+        randomizer_setup(&rand, NULL, QX_RANDOM_ENGINE_LCG);
+        uint32_t seed = rand.seed;
+
+        uint32_t out[VALUES];
+        for (size_t pos = 0; pos < VALUES; pos += block)
+                qx_randomizer_fill_u32(&rand, out + pos, qx_test_block_frames(VALUES, pos, block));
+        for (size_t i = 0; i < VALUES; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                if (out[i] != seed) {
+                        QX_CHECK(false, "lcg block %zu: %u instead of %u at %zu", block, out[i], seed, i);
+                        return;
+                }
+        }
+
+        randomizer_setup(&rand, NULL, QX_RANDOM_ENGINE_LCG);
+        qx_randomizer_skip(&rand, VALUES - 1);
+        QX_CHECK(qx_randomizer_next_u32(&rand) == out[VALUES - 1],
+                 "lcg skip: %u instead of %u", rand.seed, out[VALUES - 1]);
+}
+
+static void check_range(enum qx_random_engine_type type)
+{
+        struct qx_randomizer rand;
+        struct qx_random_engine engine;
+        randomizer_setup(&rand, &engine, type);
+
+        float out[VALUES];
+        qx_randomizer_fill(&rand, out, VALUES);
+        for (size_t i = 0; i < VALUES; i++) {
+                float steps = (out[i] - rand.min) / rand.resolution;
+                QX_CHECK(out[i] >= rand.min && out[i] <= rand.max && fabsf(steps - roundf(steps)) < 0.01f,
+                         "%s: %g not in [%g, %g] in steps of %g at %zu",
+                         engine_names[type], out[i], rand.min, rand.max, rand.resolution, i);
+        }
+}
+
+static void check_known_answers(void)
+{
+        // Random123 known-answer test, counter and key all zero
+        static const uint32_t philox[4] = {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+        uint32_t block[4];
+        qx_philox4x32(0u, 0u, 0u, block);
+        for (size_t i = 0; i < 4; i++)
+                QX_CHECK(block[i] == philox[i], "philox: %08x instead of %08x at %zu", block[i], philox[i], i);
+
+        // pcg32_srandom(42, 54) of the PCG32 reference implementation
+        static const uint32_t pcg32[] = {0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u,
+                                         0xbfa4784bu, 0xcbed606eu, 0xbfc6a3adu, 0x812fff6du,
+                                         0xe61f305au, 0xf9384b90u, 0x32db86feu, 0x1dc035f9u};
+        struct qx_random_engine eng;
+        qx_random_engine_seed_pcg32(&eng, 42u, 54u);
+        for (size_t i = 0; i < QX_TEST_COUNT(pcg32); i++) {
+                uint32_t value = qx_random_engine_next(&eng);
+                QX_CHECK(value == pcg32[i], "pcg32: %08x instead of %08x at %zu", value, pcg32[i], i);
+        }
+        uint32_t out[QX_TEST_COUNT(pcg32)];
+        qx_random_engine_seed_pcg32(&eng, 42u, 54u);
+        qx_random_engine_fill_u32(&eng, out, QX_TEST_COUNT(pcg32));
+        for (size_t i = 0; i < QX_TEST_COUNT(pcg32); i++)
+                QX_CHECK(out[i] == pcg32[i], "pcg32 fill: %08x instead of %08x at %zu", out[i], pcg32[i], i);
+        qx_random_engine_seek(&eng, 3u);
+        uint32_t value = qx_random_engine_next(&eng);
+        QX_CHECK(value == pcg32[3], "pcg32 seek: %08x instead of %08x", value, pcg32[3]);
+
+        // xoshiro128plus.c with the state {1, 2, 3, 4} in lane 0
+        static const uint32_t xoshiro[] = {0x00000005u, 0x00003007u, 0x01803007u, 0x01a05c0eu,
+                                           0x0260840au, 0x43f87e19u, 0xc3488e21u, 0xf4fd2895u};
+        qx_random_engine_seed(&eng, QX_RANDOM_ENGINE_XOSHIRO128P, 1u);
+        for (uint32_t w = 0; w < 4; w++)
+                eng.state[w * QX_XOSHIRO_LANES] = w + 1u;
+        uint32_t lanes[QX_TEST_COUNT(xoshiro) * QX_XOSHIRO_LANES];
+        qx_random_engine_fill_u32(&eng, lanes, QX_TEST_COUNT(lanes));
+        for (size_t i = 0; i < QX_TEST_COUNT(xoshiro); i++)
+                QX_CHECK(lanes[i * QX_XOSHIRO_LANES] == xoshiro[i], "xoshiro128+: %08x instead of %08x at %zu",
+                         lanes[i * QX_XOSHIRO_LANES], xoshiro[i], i);
+}
+
+static void check_fill(enum qx_random_engine_type type, size_t block)
+{
+        struct qx_randomizer ref, blk;
+        struct qx_random_engine ref_engine, blk_engine;
+        randomizer_setup(&ref, &ref_engine, type);
+        randomizer_setup(&blk, &blk_engine, type);
+
+        float out[VALUES];
+        for (size_t pos = 0; pos < VALUES; pos += block) {
+                size_t n = qx_test_block_frames(VALUES, pos, block);
+                qx_randomizer_fill(&blk, out + pos, n);
+        }
+        for (size_t i = 0; i < VALUES; i++) {
+                float expected = qx_randomizer_get_float(&ref);
+                if (memcmp(&out[i], &expected, sizeof(float)) != 0) {
+                        QX_CHECK(false, "%s fill block %zu: %g instead of %g at %zu",
+                                 engine_names[type], block, out[i], expected, i);
+                        return;
+                }
+        }
+        QX_CHECK(qx_randomizer_next_u32(&blk) == qx_randomizer_next_u32(&ref),
+                 "%s fill block %zu: different state after the fill", engine_names[type], block);
+}
+
+static void check_fill_u32(enum qx_random_engine_type type, size_t block)
+{
+        struct qx_randomizer ref, blk;
+        struct qx_random_engine ref_engine, blk_engine;
+        randomizer_setup(&ref, &ref_engine, type);
+        randomizer_setup(&blk, &blk_engine, type);
+
+        uint32_t out[VALUES];
+        for (size_t pos = 0; pos < VALUES; pos += block) {
+                size_t n = qx_test_block_frames(VALUES, pos, block);
+                qx_randomizer_fill_u32(&blk, out + pos, n);
+        }
+        for (size_t i = 0; i < VALUES; i++) {
+                uint32_t expected = qx_randomizer_next_u32(&ref);
+                if (out[i] != expected) {
+                        QX_CHECK(false, "%s fill_u32 block %zu: %u instead of %u at %zu",
+                                 engine_names[type], block, out[i], expected, i);
+                        return;
+                }
+        }
+        QX_CHECK(qx_randomizer_get_float(&blk) == qx_randomizer_get_float(&ref),
+                 "%s fill_u32 block %zu: different state after the fill", engine_names[type], block);
+}
+
+static void check_fill_at(void)
+{
+        struct qx_randomizer rand;
+        randomizer_setup(&rand, NULL, QX_RANDOM_ENGINE_LCG);
+
+        float out[VALUES];
+        const uint64_t key = 0xfeedface12345678ull;
+        const uint64_t counter = (1ull << 32) - 100u;
+        qx_randomizer_fill_at(&rand, key, counter, out, VALUES);
+        for (size_t i = 0; i < VALUES; i++) {
+                float expected = qx_randomizer_get_float_at(&rand, key, counter + i);
+                if (memcmp(&out[i], &expected, sizeof(float)) != 0) {
+                        QX_CHECK(false, "fill_at: %g instead of %g at %zu", out[i], expected, i);
+                        return;
+                }
+        }
+}
+
+int main(void)
+{
+        check_known_answers();
+        for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                check_lcg(blocks[b]);
+
+        for (int type = 0; type <= QX_RANDOM_ENGINE_PHILOX; type++) {
+                check_range((enum qx_random_engine_type)type);
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                        check_fill((enum qx_random_engine_type)type, blocks[b]);
+                        check_fill_u32((enum qx_random_engine_type)type, blocks[b]);
+                }
+        }
+        check_fill_at();
+
+        return qx_test_result("test_randomizer");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_seed.c
+ * @brief Checks that the process-wide seed source never repeats a seed.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Several threads take seeds from the process-wide seed source, both
+ * in this file and in test_seed_tu.c, which has its own copies of the
+ * inline functions, mixing single inits, batches and seed streams. Every
+ * randomizer must get a different seed. A batch must get the same seeds
+ * as single inits from the same counter position.
+ */
+
+#include "qx_randomizer.h"
+#include "qx_test.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define THREADS 8
+#define ROUNDS 200
+#define SINGLE_SEEDS 2
+#define BATCH_SEEDS 7
+#define STREAM_SEEDS 5
+#define TU_SEEDS 3
+#define SEEDS_PER_ROUND (SINGLE_SEEDS + BATCH_SEEDS + 2 * STREAM_SEEDS + TU_SEEDS)
+#define BATCH_SIZE 300
+
+void seed_tu_take(uint32_t* seeds, size_t n);
+
+static uint32_t seeds[THREADS][ROUNDS * SEEDS_PER_ROUND];
+
+static void* take_seeds(void* arg)
+{
+        uint32_t* out = seeds[(size_t)arg];
+        struct qx_seed_stream stream = {0, 0};
+        for (size_t r = 0; r < ROUNDS; r++) {
+                struct qx_randomizer rands[BATCH_SEEDS];
+                struct qx_random_engine engines[BATCH_SEEDS];
+                for (size_t i = 0; i < SINGLE_SEEDS; i++) {
+                        qx_randomizer_init_engine(&rands[i], &engines[i], QX_RANDOM_ENGINE_PCG32, 0.0f, 1.0f, 0.001f);
+                        *out++ = rands[i].seed;
+                }
+
+                qx_randomizer_init_batch(rands, r % 2 ? engines : NULL, BATCH_SEEDS,
+                                         QX_RANDOM_ENGINE_PHILOX, 0.0f, 1.0f, 0.001f);
+                for (size_t i = 0; i < BATCH_SEEDS; i++)
+                        *out++ = rands[i].seed;
+
+                qx_randomizer_init_stream(NULL, rands, NULL, STREAM_SEEDS, QX_RANDOM_ENGINE_LCG, 0.0f, 1.0f, 0.001f);
+                for (size_t i = 0; i < STREAM_SEEDS; i++)
+                        *out++ = rands[i].seed;
+
+                qx_randomizer_init_stream(&stream, rands, NULL, STREAM_SEEDS, QX_RANDOM_ENGINE_LCG, 0.0f, 1.0f, 0.001f);
+                for (size_t i = 0; i < STREAM_SEEDS; i++)
+                        *out++ = rands[i].seed;
+
+                seed_tu_take(out, TU_SEEDS);
+                out += TU_SEEDS;
+        }
+        return NULL;
+}
+
+static int compare_seeds(const void* a, const void* b)
+{
+        uint32_t x = *(const uint32_t*)a;
+        uint32_t y = *(const uint32_t*)b;
+        return x < y ? -1 : x > y;
+}
+
+static void check_unique(void)
+{
+        pthread_t threads[THREADS];
+        for (size_t t = 0; t < THREADS; t++) {
+                if (pthread_create(&threads[t], NULL, take_seeds, (void*)t) != 0) {
+                        QX_CHECK(false, "cannot start thread %zu", t);
+                        exit(1);
+                }
+        }
+        for (size_t t = 0; t < THREADS; t++)
+                pthread_join(threads[t], NULL);
+
+        uint32_t* all = &seeds[0][0];
+        const size_t count = THREADS * ROUNDS * SEEDS_PER_ROUND;
+        qsort(all, count, sizeof(uint32_t), compare_seeds);
+        size_t repeated = 0;
+        for (size_t i = 1; i < count; i++)
+                repeated += all[i] == all[i - 1];
+        QX_CHECK(repeated == 0, "%zu of %zu seeds repeated", repeated, count);
+}
+
+static void check_batch(void)
+{
+        // The thread stream of main() is still empty here
+        static struct qx_randomizer single[BATCH_SIZE];
+        static struct qx_randomizer batch[BATCH_SIZE];
+        const unsigned int start = atomic_load(&qx_seed_counter);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+                qx_randomizer_init(&single[i], 0.0f, 1.0f, 0.001f);
+        const unsigned int end = atomic_load(&qx_seed_counter);
+
+        atomic_store(&qx_seed_counter, start);
+        qx_randomizer_init_batch(batch, NULL, BATCH_SIZE, QX_RANDOM_ENGINE_LCG, 0.0f, 1.0f, 0.001f);
+        QX_CHECK(atomic_load(&qx_seed_counter) == start + BATCH_SIZE,
+                 "batch reserved %u seeds instead of %d", atomic_load(&qx_seed_counter) - start, BATCH_SIZE);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+                QX_CHECK(batch[i].seed == single[i].seed, "batch seed %u instead of %u at %zu",
+                         batch[i].seed, single[i].seed, i);
+
+        // Past the seeds still left in the thread stream
+        atomic_store(&qx_seed_counter, end);
+}
+
+int main(void)
+{
+        check_batch();
+        check_unique();
+        return qx_test_result("test_seed");
+}
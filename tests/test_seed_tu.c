@@ -0,0 +1,48 @@
+/**
+ * @file test_seed_tu.c
+ * @brief Second translation unit of test_seed.
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * Compiled separately from test_seed.c, so this file has its own copies
+ * of the static inline seed functions and of their thread-local seed
+ * stream. The seeds taken here must still differ from those of the other
+ * file.
+ */
+
+#include "qx_randomizer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+void seed_tu_take(uint32_t* seeds, size_t n);
+
+void seed_tu_take(uint32_t* seeds, size_t n)
+{
+        for (size_t i = 0; i < n; i++) {
+                struct qx_randomizer rand;
+                qx_randomizer_init(&rand, 0.0f, 1.0f, 0.001f);
+                seeds[i] = rand.seed;
+        }
+}
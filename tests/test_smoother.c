@@ -0,0 +1,185 @@
+/**
+ * @file test_smoother.c
+ * @brief Block smoother processing against qx_smoother_next().
+ *
+ * Project: Quamplex DSP Tools (A small C library of tools for audio DSP processing)
+ * Website: https://quamplex.com
+ *
+ * Copyright (C) 2025 Iurie Nistor
+ *
+ * This file is part of Quamplex DSP Tools.
+ *
+ * Quamplex DSP Tools is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * A linear ramp over RAMP_FRAMES frames must produce
+ * from + (to - from) * (i + 1) / RAMP_FRAMES at frame i and then the
+ * target exactly. The other shapes must follow their formulas at
+ * t = k / RAMP_FRAMES after k calls of qx_smoother_next():
+ * exponential to + (from - to) * QX_SMOOTHER_EXP_RESIDUAL^t, logarithmic
+ * from * (to / from)^t and S-curve from + (to - from) * (3t^2 - 2t^3).
+ * qx_smoother_remaining() must count down to 0 on the frame that
+ * reaches the target, and a settled smoother must keep it.
+ *
+ * qx_smoother_process_block() and qx_smoother_apply_gain_block() compute
+ * the ramp in closed form; they must match repeated qx_smoother_next()
+ * calls for every shape and block size, reach the target exactly on the
+ * same frame and end in the same state. qx_smoother_next() accumulates a
+ * rounding error of up to one float epsilon of the values per frame, so
+ * the ramps are compared within RAMP_FRAMES epsilons.
+ */
+
+#include "qx_smoother.h"
+#include "qx_test.h"
+
+#include <float.h>
+#include <math.h>
+
+#define FRAMES 1000
+#define RAMP_FRAMES 300
+#define TOLERANCE (RAMP_FRAMES * FLT_EPSILON)
+
+static const char* const shape_names[] = {"linear", "exponential", "logarithmic", "s-curve"};
+
+static const size_t blocks[] = {1, 5, 64, 100, 299, 300, FRAMES};
+
+static float input[FRAMES];
+
+static void smoother_setup(qx_smoother* s, enum qx_smoother_shape shape, float from, float to)
+{
+        qx_smoother_init(s, from, RAMP_FRAMES);
+        qx_smoother_set_shape(s, shape);
+        qx_smoother_set_target(s, to);
+}
+
+static void check_linear(float from, float to, size_t block)
+{
+        qx_smoother s;
+        smoother_setup(&s, QX_SMOOTHER_LINEAR, from, to);
+
+        float out[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block)
+                qx_smoother_process_block(&s, out + pos, qx_test_block_frames(FRAMES, pos, block));
+
+        float scale = fmaxf(fmaxf(fabsf(from), fabsf(to)), 1.0f);
+        for (size_t i = 0; i < FRAMES; i++) {
+                double expected = i + 1 < RAMP_FRAMES ? from + (to - (double)from) * (double)(i + 1) / RAMP_FRAMES
+                                                      : to;
+                bool ok = i + 1 < RAMP_FRAMES ? fabs(out[i] - expected) <= TOLERANCE * scale : out[i] == to;
+                if (!ok) {
+                        QX_CHECK(false, "linear %g -> %g block %zu: %.9g instead of %.9g at %zu",
+                                 from, to, block, out[i], expected, i);
+                        return;
+                }
+        }
+}
+
+static double shape_value(enum qx_smoother_shape shape, double from, double to, double t)
+{
+        switch (shape) {
+        case QX_SMOOTHER_EXPONENTIAL:
+                return to + (from - to) * pow(QX_SMOOTHER_EXP_RESIDUAL, t);
+        case QX_SMOOTHER_LOGARITHMIC:
+                return from * pow(to / from, t);
+        case QX_SMOOTHER_SCURVE:
+                return from + (to - from) * t * t * (3.0 - 2.0 * t);
+        case QX_SMOOTHER_LINEAR:
+        default:
+                return from + (to - from) * t;
+        }
+}
+
+static void check_shape(enum qx_smoother_shape shape, float from, float to)
+{
+        qx_smoother s;
+        smoother_setup(&s, shape, from, to);
+
+        float scale = fmaxf(fmaxf(fabsf(from), fabsf(to)), 1.0f);
+        for (size_t k = 1; k <= RAMP_FRAMES + 10; k++) {
+                float value = qx_smoother_next(&s);
+                size_t remaining = k < RAMP_FRAMES ? RAMP_FRAMES - k : 0;
+                QX_CHECK(qx_smoother_remaining(&s) == remaining, "%s %g -> %g: %zu frames remaining instead of %zu",
+                         shape_names[shape], from, to, qx_smoother_remaining(&s), remaining);
+                if (k >= RAMP_FRAMES) {
+                        QX_CHECK(value == to, "%s %g -> %g: %.9g instead of the target after %zu",
+                                 shape_names[shape], from, to, value, k);
+                } else if (k % (RAMP_FRAMES / 4) == 0 || k == 1 || k == RAMP_FRAMES - 1) {
+                        double expected = shape_value(shape, from, to, (double)k / RAMP_FRAMES);
+                        QX_CHECK(fabs(value - expected) <= TOLERANCE * scale, "%s %g -> %g: %.9g instead of %.9g after %zu",
+                                 shape_names[shape], from, to, value, expected, k);
+                }
+        }
+}
+
+static void check_block(enum qx_smoother_shape shape, float from, float to, size_t block, bool gain)
+{
+        qx_smoother ref, blk;
+        smoother_setup(&ref, shape, from, to);
+        smoother_setup(&blk, shape, from, to);
+        const char* name = gain ? "apply_gain_block" : "process_block";
+
+        float out[FRAMES];
+        for (size_t pos = 0; pos < FRAMES; pos += block) {
+                size_t n = qx_test_block_frames(FRAMES, pos, block);
+                if (gain)
+                        qx_smoother_apply_gain_block(&blk, input + pos, out + pos, n);
+                else
+                        qx_smoother_process_block(&blk, out + pos, n);
+
+                for (size_t i = pos; i < pos + n; i++) {
+                        float value = qx_smoother_next(&ref);
+                        float expected = gain ? input[i] * value : value;
+                        float scale = fmaxf(fmaxf(fabsf(from), fabsf(to)), 1.0f);
+                        bool ok = qx_smoother_remaining(&ref) == 0 ? out[i] == expected
+                                                                   : fabsf(out[i] - expected) <= TOLERANCE * scale;
+                        if (!ok) {
+                                QX_CHECK(false, "%s %s %g -> %g block %zu: %.9g instead of %.9g at %zu",
+                                         shape_names[shape], name, from, to, block, out[i], expected, i);
+                                return;
+                        }
+                }
+                QX_CHECK(qx_smoother_remaining(&blk) == qx_smoother_remaining(&ref),
+                         "%s %s block %zu: %zu frames remaining instead of %zu", shape_names[shape],
+                         name, block, qx_smoother_remaining(&blk), qx_smoother_remaining(&ref));
+        }
+        QX_CHECK(qx_smoother_get(&blk) == to, "%s %s: ends at %g instead of %g",
+                 shape_names[shape], name, qx_smoother_get(&blk), to);
+}
+
+int main(void)
+{
+        for (size_t i = 0; i < FRAMES; i++)
+                input[i] = cosf(0.01f * (float)i);
+
+        static const float ramps[][2] = {{0.0f, 1.0f}, {1.0f, 0.001f}, {-2.0f, 3.5f}, {200.0f, 20.0f}};
+        for (size_t r = 0; r < QX_TEST_COUNT(ramps); r++) {
+                for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++)
+                        check_linear(ramps[r][0], ramps[r][1], blocks[b]);
+        }
+
+        for (int shape = 0; shape <= QX_SMOOTHER_SCURVE; shape++) {
+                for (size_t r = 0; r < QX_TEST_COUNT(ramps); r++) {
+                        if (shape != QX_SMOOTHER_LOGARITHMIC || ramps[r][0] * ramps[r][1] > 0.0f)
+                                check_shape((enum qx_smoother_shape)shape, ramps[r][0], ramps[r][1]);
+                        for (size_t b = 0; b < QX_TEST_COUNT(blocks); b++) {
+                                check_block((enum qx_smoother_shape)shape, ramps[r][0], ramps[r][1], blocks[b], false);
+                                check_block((enum qx_smoother_shape)shape, ramps[r][0], ramps[r][1], blocks[b], true);
+                        }
+                }
+        }
+
+        return qx_test_result("test_smoother");
+}